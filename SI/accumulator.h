@@ -0,0 +1,200 @@
+// <SI/accumulator.h> - compensated and reproducible sums of quantities, e.g. SI::sum(parallel, energies) or accumulator<length3>
+//                     (compensated summation in fixed blocks and lanes, so the total is bit-identical for any number of threads)
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <SI/batch.h>
+
+namespace SI
+{
+	namespace detail
+	{
+		// a running sum plus the rounding errors lost so far (Kahan-Babuška-Neumaier summation)
+		struct compensated
+		{
+			SIdouble sum = 0;
+			SIdouble compensation = 0;
+
+			constexpr SIdouble total() const { return sum + compensation; }
+		};
+
+		// Adds x to the compensated sum. The rounding error of sum + x is recovered exactly by Knuth's TwoSum, which
+		// needs no comparison of the magnitudes like Neumaier's original, so the loops stay branch-free and vectorize.
+		constexpr void add(SIdouble& sum, SIdouble& compensation, SIdouble x)
+		{
+			const SIdouble t = sum + x, z = t - sum;
+			compensation += (sum - (t - z)) + (x - z);
+			sum = t;
+		}
+
+		constexpr void add(compensated& a, SIdouble x)
+		{
+			add(a.sum, a.compensation, x);
+		}
+
+		constexpr void add(compensated& a, const compensated& b) // (merges b into a)
+		{
+			add(a.sum, a.compensation, b.sum);
+			a.compensation += b.compensation;
+		}
+
+		// the components of the value types to sum (scalars, vec2, vec3)
+		template <class T> struct components { static constexpr size_t count = 1; };
+		template <class T> struct components<internal::vec2<T>> { static constexpr size_t count = 2; };
+		template <class T> struct components<internal::vec3<T>> { static constexpr size_t count = 3; };
+
+		template <class T> constexpr SIdouble component(const T& x, size_t) { return static_cast<SIdouble>(x); }
+		template <class T> constexpr SIdouble component(const internal::vec2<T>& v, size_t i) { return i == 0 ? v.x : v.y; }
+		template <class T> constexpr SIdouble component(const internal::vec3<T>& v, size_t i) { return i == 0 ? v.x : i == 1 ? v.y : v.z; }
+
+		template <class T, size_t N> constexpr T from_components(const std::array<SIdouble, N>& c)
+		{
+			if constexpr (N == 1)
+				return static_cast<T>(c[0]);
+			else if constexpr (N == 2)
+				return { c[0], c[1] };
+			else
+				return { c[0], c[1], c[2] };
+		}
+
+		template <class Q> struct value_type_of { using type = Q; };
+		template <class Dimension, class T> struct value_type_of<quantity<Dimension, T>> { using type = T; };
+		template <class Q> using value_type_of_t = typename value_type_of<Q>::type;
+
+		// Sums are formed in blocks of sum_block elements (the unit of work per thread), each spread over sum_lanes
+		// independent compensated sums, which the compiler keeps side by side in SIMD registers. Both are fixed, so
+		// the order of all additions is the same for any number of threads.
+		constexpr size_t sum_block = 4096;
+		constexpr size_t sum_lanes = 8;
+
+		template <class Q>
+		compensated sum_block_of(const Q* x, size_t count, size_t component_index)
+		{
+			SIdouble sums[sum_lanes] = {}, compensations[sum_lanes] = {};
+			size_t i = 0;
+			for (; i + sum_lanes <= count; i += sum_lanes)
+			{
+				for (size_t lane = 0; lane < sum_lanes; lane++)
+					add(sums[lane], compensations[lane], component(value(x[i + lane]), component_index));
+			}
+			for (size_t lane = 0; i < count; i++, lane++)
+				add(sums[lane], compensations[lane], component(value(x[i]), component_index));
+
+			compensated result;
+			for (size_t lane = 0; lane < sum_lanes; lane++) // (always in lane order)
+				add(result, { sums[lane], compensations[lane] });
+			return result;
+		}
+	}
+
+	// A compensated sum of quantities (or of vec2/vec3 quantities componentwise), e.g. accumulator<energy>. Adding
+	// values one by one with += is exact up to the final rounding for about 2^53 additions, unlike a naive sum whose
+	// error grows with the count. Merging accumulators with += is deterministic for a fixed merge order.
+	template <class Q>
+	class accumulator
+	{
+	public:
+		using value_type = detail::value_type_of_t<Q>;
+		static constexpr size_t components = detail::components<value_type>::count;
+
+		constexpr accumulator() = default;
+
+		constexpr accumulator& operator+=(const Q& x)
+		{
+			for (size_t i = 0; i < components; i++)
+				detail::add(m_parts[i], detail::component(value(x), i));
+			return *this;
+		}
+
+		constexpr accumulator& operator+=(const accumulator& other)
+		{
+			for (size_t i = 0; i < components; i++)
+				detail::add(m_parts[i], other.m_parts[i]);
+			return *this;
+		}
+
+		// Returns the sum of all values added so far.
+		constexpr Q total() const
+		{
+			std::array<SIdouble, components> c = {};
+			for (size_t i = 0; i < components; i++)
+				c[i] = m_parts[i].total();
+			if constexpr (detail::is_si_v<Q>)
+				return Q(typename Q::dimension_type(), detail::from_components<value_type>(c));
+			else
+				return detail::from_components<value_type>(c);
+		}
+
+		// Adds count values at once (in lanes, see detail::sum_block, for the same result as accumulate()).
+		void add(const Q* x, size_t count)
+		{
+			for (size_t begin = 0; begin < count; begin += detail::sum_block)
+				add_block(x + begin, std::min(detail::sum_block, count - begin));
+		}
+
+		void add_block(const Q* x, size_t count)
+		{
+			for (size_t i = 0; i < components; i++)
+				detail::add(m_parts[i], detail::sum_block_of(x, count, i));
+		}
+
+	private:
+		detail::compensated m_parts[components] = {};
+	};
+
+	// Sums many quantities with compensation, e.g. accumulate(energies).total() (vectorized, see accumulator::add()).
+	template <class In, class Q = detail::element_of_t<const In>>
+	accumulator<Q> accumulate(const In& in)
+	{
+		const span<const Q> x(in);
+		SI_CHECK_FP("accumulate", Q);
+		accumulator<Q> result;
+		result.add(x.data(), x.size());
+		return result;
+	}
+
+	// Sums many quantities with compensation, multithreaded. Each thread sums whole blocks and the blocks are merged
+	// in their order afterwards, so the total is bit-identical to accumulate(in) for any number of threads.
+	template <class In, class Q = detail::element_of_t<const In>>
+	accumulator<Q> accumulate(const parallel_t& policy, const In& in)
+	{
+		const span<const Q> x(in);
+		SI_CHECK_FP("accumulate", Q);
+		const size_t blocks = (x.size() + detail::sum_block - 1) / detail::sum_block;
+		std::vector<accumulator<Q>> block_sums(blocks);
+		detail::parallel_for({ std::max<size_t>(1, policy.min_batch / detail::sum_block) }, blocks, [&](size_t begin, size_t end)
+		{
+			for (size_t block = begin; block < end; block++)
+			{
+				const size_t first = block * detail::sum_block;
+				block_sums[block].add_block(x.data() + first, std::min(detail::sum_block, x.size() - first));
+			}
+		});
+		accumulator<Q> result;
+		for (const auto& block_sum : block_sums) // (always in block order)
+			result += block_sum;
+		return result;
+	}
+
+	// Returns the compensated sum of many quantities, e.g. sum(masses) or sum(parallel, energies).
+	template <class In, class Q = detail::element_of_t<const In>>
+	Q sum(const In& in)
+	{
+		return accumulate<In, Q>(in).total();
+	}
+
+	template <class In, class Q = detail::element_of_t<const In>>
+	Q sum(const parallel_t& policy, const In& in)
+	{
+		return accumulate<In, Q>(policy, in).total();
+	}
+
+} // namespace SI
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Kahan_summation_algorithm#Further_enhancements (Neumaier's variant)
+// 2. https://en.wikipedia.org/wiki/2Sum (Knuth's TwoSum)
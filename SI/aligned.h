@@ -0,0 +1,238 @@
+// <SI/aligned.h> - aligned and tiled storage for 3D quantities, e.g. length_t<vec3a<SIdouble>> or length_t<tile3<SIdouble>>
+//                  (value types for quantity like vec3, but laid out for aligned SIMD loads instead of packed 24 bytes)
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <SI/batch.h>
+
+// Which layout wins depends on the loop: vec3a trades 33% more memory for aligned loads, so it pays off when the
+// vectors stay in the cache and are used whole, tile3 pays off in streaming loops over many vectors (see the vector
+// layouts of benchmarks.cpp, where a memory-bound SSE2 machine measured length3 vs. vec3a vs. tile3 as 1.0/0.8/1.1).
+namespace SI
+{
+	namespace internal
+	{
+		// A 3D vector padded to 4 lanes and aligned to their size (32 bytes for doubles), so it never straddles a
+		// cache line and loads into one 256-bit register. The padding lane w stays 0, so operations can run on all
+		// 4 lanes at once.
+		template <class T>
+		struct alignas(4 * sizeof(T)) vec3a
+		{
+			static_assert(std::is_arithmetic_v<T>);
+
+			T x = 0;
+			T y = 0;
+			T z = 0;
+			T w = 0; // (padding)
+
+			constexpr vec3a() = default;
+
+			constexpr vec3a(T x, T y, T z) : x(x), y(y), z(z) {}
+
+			template <class U>
+			constexpr vec3a(const vec3<U>& v) : x(v.x), y(v.y), z(v.z) {} // NOLINT(google-explicit-constructor)
+
+			template <class U>
+			constexpr operator vec3<U>() const { return vec3<U>(x, y, z); } // NOLINT(google-explicit-constructor)
+		};
+
+		// N scalars side by side, e.g. the dot products of a tile3 (one lane per element, the compiler keeps the loops
+		// over the lanes in vector registers)
+		template <class T, size_t N = 8>
+		struct alignas(N * sizeof(T) < 64 ? N * sizeof(T) : 64) tile
+		{
+			static_assert(std::is_arithmetic_v<T> && N > 0 && (N & (N - 1)) == 0, "the lanes of a tile must be a power of 2");
+			static constexpr size_t size = N;
+
+			T lanes[N] = {};
+
+			constexpr T& operator[](size_t i) { return lanes[i]; }
+			constexpr const T& operator[](size_t i) const { return lanes[i]; }
+		};
+
+		// N 3D vectors as structure of arrays (x of all, then y of all, then z of all), so an array of tiles is an
+		// "array of structures of arrays" (AoSoA): SIMD loads get N x (or y, z) at once without gathering, and a tile
+		// still fits into a few cache lines.
+		template <class T, size_t N = 8>
+		struct alignas(N * sizeof(T) < 64 ? N * sizeof(T) : 64) tile3
+		{
+			static constexpr size_t size = N;
+
+			tile<T, N> x;
+			tile<T, N> y;
+			tile<T, N> z;
+
+			constexpr vec3<T> get(size_t i) const { return { x[i], y[i], z[i] }; }
+			constexpr void set(size_t i, const vec3<T>& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+		};
+
+		// +++ vec3a +++
+		template <class T> [[nodiscard]] constexpr vec3a<T> operator-(const vec3a<T>& v) { return { -v.x, -v.y, -v.z }; }
+		template <class T, class U> [[nodiscard]] constexpr bool operator==(const vec3a<T>& lhs, const vec3a<U>& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z; }
+		template <class T, class U> [[nodiscard]] constexpr bool operator!=(const vec3a<T>& lhs, const vec3a<U>& rhs) { return !(lhs == rhs); }
+
+		template <class T> constexpr vec3a<T>& operator+=(vec3a<T>& lhs, const vec3a<T>& rhs) { lhs.x += rhs.x; lhs.y += rhs.y; lhs.z += rhs.z; lhs.w += rhs.w; return lhs; }
+		template <class T> constexpr vec3a<T>& operator-=(vec3a<T>& lhs, const vec3a<T>& rhs) { lhs.x -= rhs.x; lhs.y -= rhs.y; lhs.z -= rhs.z; lhs.w -= rhs.w; return lhs; }
+		template <class T, class U, class = enable_for_scalar<U>> constexpr vec3a<T>& operator*=(vec3a<T>& lhs, U rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; lhs.w *= rhs; return lhs; }
+		template <class T, class U, class = enable_for_scalar<U>> constexpr vec3a<T>& operator/=(vec3a<T>& lhs, U rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; lhs.w /= rhs; return lhs; }
+
+		template <class T> [[nodiscard]] constexpr vec3a<T> operator+(const vec3a<T>& lhs, const vec3a<T>& rhs) { vec3a<T> result = lhs; return result += rhs; }
+		template <class T> [[nodiscard]] constexpr vec3a<T> operator-(const vec3a<T>& lhs, const vec3a<T>& rhs) { vec3a<T> result = lhs; return result -= rhs; }
+		template <class T> [[nodiscard]] constexpr vec3a<T> operator*(const vec3a<T>& lhs, const vec3a<T>& rhs) { return { lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z }; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr vec3a<T> operator*(const vec3a<T>& lhs, U rhs) { vec3a<T> result = lhs; return result *= rhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr vec3a<T> operator*(U lhs, const vec3a<T>& rhs) { vec3a<T> result = rhs; return result *= lhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr vec3a<T> operator/(const vec3a<T>& lhs, U rhs) { vec3a<T> result = lhs; return result /= rhs; }
+
+		template <class T> [[nodiscard]] constexpr vec3a<T> abs(const vec3a<T>& v) { return { std::abs(v.x), std::abs(v.y), std::abs(v.z) }; }
+		template <class T> [[nodiscard]] constexpr T dot(const vec3a<T>& lhs, const vec3a<T>& rhs) { return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z; }
+		template <class T> [[nodiscard]] constexpr vec3a<T> cross(const vec3a<T>& lhs, const vec3a<T>& rhs) { return { lhs.y * rhs.z - rhs.y * lhs.z, lhs.z * rhs.x - rhs.z * lhs.x, lhs.x * rhs.y - rhs.x * lhs.y }; }
+		template <class T> [[nodiscard]] inline T length(const vec3a<T>& v) { return std::sqrt(dot(v, v)); }
+		template <class T> [[nodiscard]] inline T distance(const vec3a<T>& a, const vec3a<T>& b) { return length(b - a); }
+		template <class T> [[nodiscard]] inline vec3a<T> normalize(const vec3a<T>& v) { const T l = length(v); return v * (l ? (1 / l) : 0); }
+
+		// +++ tile and tile3 (lanewise) +++
+#define SI_TILE_LOOP(_expression) for (size_t i = 0; i < N; i++) _expression
+
+		template <class T, size_t N> [[nodiscard]] constexpr tile<T, N> operator-(const tile<T, N>& v) { tile<T, N> result; SI_TILE_LOOP(result[i] = -v[i]); return result; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator-(const tile3<T, N>& v) { return { -v.x, -v.y, -v.z }; }
+		template <class T, size_t N> [[nodiscard]] constexpr bool operator==(const tile<T, N>& lhs, const tile<T, N>& rhs) { bool equal = true; SI_TILE_LOOP(equal = equal && lhs[i] == rhs[i]); return equal; }
+		template <class T, size_t N> [[nodiscard]] constexpr bool operator==(const tile3<T, N>& lhs, const tile3<T, N>& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z; }
+		template <class T, size_t N> [[nodiscard]] constexpr bool operator!=(const tile<T, N>& lhs, const tile<T, N>& rhs) { return !(lhs == rhs); }
+		template <class T, size_t N> [[nodiscard]] constexpr bool operator!=(const tile3<T, N>& lhs, const tile3<T, N>& rhs) { return !(lhs == rhs); }
+
+		template <class T, size_t N> constexpr tile<T, N>& operator+=(tile<T, N>& lhs, const tile<T, N>& rhs) { SI_TILE_LOOP(lhs[i] += rhs[i]); return lhs; }
+		template <class T, size_t N> constexpr tile<T, N>& operator-=(tile<T, N>& lhs, const tile<T, N>& rhs) { SI_TILE_LOOP(lhs[i] -= rhs[i]); return lhs; }
+		template <class T, size_t N> constexpr tile<T, N>& operator*=(tile<T, N>& lhs, const tile<T, N>& rhs) { SI_TILE_LOOP(lhs[i] *= rhs[i]); return lhs; }
+		template <class T, size_t N> constexpr tile<T, N>& operator/=(tile<T, N>& lhs, const tile<T, N>& rhs) { SI_TILE_LOOP(lhs[i] /= rhs[i]); return lhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> constexpr tile<T, N>& operator*=(tile<T, N>& lhs, U rhs) { SI_TILE_LOOP(lhs[i] *= rhs); return lhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> constexpr tile<T, N>& operator/=(tile<T, N>& lhs, U rhs) { SI_TILE_LOOP(lhs[i] /= rhs); return lhs; }
+
+		template <class T, size_t N> [[nodiscard]] constexpr tile<T, N> operator+(const tile<T, N>& lhs, const tile<T, N>& rhs) { tile<T, N> result = lhs; return result += rhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile<T, N> operator-(const tile<T, N>& lhs, const tile<T, N>& rhs) { tile<T, N> result = lhs; return result -= rhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile<T, N> operator*(const tile<T, N>& lhs, const tile<T, N>& rhs) { tile<T, N> result = lhs; return result *= rhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile<T, N> operator/(const tile<T, N>& lhs, const tile<T, N>& rhs) { tile<T, N> result = lhs; return result /= rhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr tile<T, N> operator*(const tile<T, N>& lhs, U rhs) { tile<T, N> result = lhs; return result *= rhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr tile<T, N> operator*(U lhs, const tile<T, N>& rhs) { tile<T, N> result = rhs; return result *= lhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr tile<T, N> operator/(const tile<T, N>& lhs, U rhs) { tile<T, N> result = lhs; return result /= rhs; }
+
+		template <class T, size_t N> constexpr tile3<T, N>& operator+=(tile3<T, N>& lhs, const tile3<T, N>& rhs) { lhs.x += rhs.x; lhs.y += rhs.y; lhs.z += rhs.z; return lhs; }
+		template <class T, size_t N> constexpr tile3<T, N>& operator-=(tile3<T, N>& lhs, const tile3<T, N>& rhs) { lhs.x -= rhs.x; lhs.y -= rhs.y; lhs.z -= rhs.z; return lhs; }
+		template <class T, size_t N> constexpr tile3<T, N>& operator*=(tile3<T, N>& lhs, const tile<T, N>& rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; return lhs; }
+		template <class T, size_t N> constexpr tile3<T, N>& operator/=(tile3<T, N>& lhs, const tile<T, N>& rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; return lhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> constexpr tile3<T, N>& operator*=(tile3<T, N>& lhs, U rhs) { lhs.x *= rhs; lhs.y *= rhs; lhs.z *= rhs; return lhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> constexpr tile3<T, N>& operator/=(tile3<T, N>& lhs, U rhs) { lhs.x /= rhs; lhs.y /= rhs; lhs.z /= rhs; return lhs; }
+
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator+(const tile3<T, N>& lhs, const tile3<T, N>& rhs) { tile3<T, N> result = lhs; return result += rhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator-(const tile3<T, N>& lhs, const tile3<T, N>& rhs) { tile3<T, N> result = lhs; return result -= rhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator*(const tile3<T, N>& lhs, const tile<T, N>& rhs) { tile3<T, N> result = lhs; return result *= rhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator*(const tile<T, N>& lhs, const tile3<T, N>& rhs) { tile3<T, N> result = rhs; return result *= lhs; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator/(const tile3<T, N>& lhs, const tile<T, N>& rhs) { tile3<T, N> result = lhs; return result /= rhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr tile3<T, N> operator*(const tile3<T, N>& lhs, U rhs) { tile3<T, N> result = lhs; return result *= rhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr tile3<T, N> operator*(U lhs, const tile3<T, N>& rhs) { tile3<T, N> result = rhs; return result *= lhs; }
+		template <class T, size_t N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr tile3<T, N> operator/(const tile3<T, N>& lhs, U rhs) { tile3<T, N> result = lhs; return result /= rhs; }
+
+		template <class T, size_t N> [[nodiscard]] inline tile<T, N> abs(const tile<T, N>& v) { tile<T, N> result; SI_TILE_LOOP(result[i] = std::abs(v[i])); return result; }
+		template <class T, size_t N> [[nodiscard]] inline tile3<T, N> abs(const tile3<T, N>& v) { return { abs(v.x), abs(v.y), abs(v.z) }; }
+		template <class T, size_t N> [[nodiscard]] inline tile<T, N> sqrt(const tile<T, N>& v) { tile<T, N> result; SI_TILE_LOOP(result[i] = std::sqrt(v[i])); return result; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile<T, N> dot(const tile3<T, N>& lhs, const tile3<T, N>& rhs) { return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z; }
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> cross(const tile3<T, N>& lhs, const tile3<T, N>& rhs) { return { lhs.y * rhs.z - rhs.y * lhs.z, lhs.z * rhs.x - rhs.z * lhs.x, lhs.x * rhs.y - rhs.x * lhs.y }; }
+		template <class T, size_t N> [[nodiscard]] inline tile<T, N> length(const tile3<T, N>& v) { return sqrt(dot(v, v)); }
+		template <class T, size_t N> [[nodiscard]] inline tile<T, N> distance(const tile3<T, N>& a, const tile3<T, N>& b) { return length(b - a); }
+
+		// (returns null vectors when given null vectors, like normalize() of vec3)
+		template <class T, size_t N>
+		[[nodiscard]] inline tile3<T, N> normalize(const tile3<T, N>& v)
+		{
+			const tile<T, N> l = length(v);
+			tile<T, N> inverse;
+			SI_TILE_LOOP(inverse[i] = 1 / (l[i] > 0 ? l[i] : std::numeric_limits<T>::infinity())); // (1/inf = 0, without a branch)
+			return v * inverse;
+		}
+
+#undef SI_TILE_LOOP
+
+		// (for quantity::infinity() and NaN())
+		template <class T>
+		constexpr void fill(vec3a<T>& x, T value)
+		{
+			x = { value, value, value };
+		}
+
+		template <class T, size_t N>
+		constexpr void fill(tile<T, N>& x, T value)
+		{
+			for (auto& lane : x.lanes)
+				lane = value;
+		}
+
+		template <class T, size_t N>
+		constexpr void fill(tile3<T, N>& x, T value)
+		{
+			fill(x.x, value);
+			fill(x.y, value);
+			fill(x.z, value);
+		}
+	}
+
+	namespace detail
+	{
+		template <class T> struct scalar_value_type<internal::vec3a<T>> { using type = T; };
+		template <class T, size_t N> struct scalar_value_type<internal::tile<T, N>> { using type = T; };
+		template <class T, size_t N> struct scalar_value_type<internal::tile3<T, N>> { using type = T; };
+		template <class T> struct is_arithmetic<internal::vec3a<T>> : std::true_type {}; // (for units, e.g. meters(vec3a(1.0, 2.0, 3.0)))
+		template <class T, size_t N> struct is_arithmetic<internal::tile<T, N>> : std::true_type {};
+		template <class T, size_t N> struct is_arithmetic<internal::tile3<T, N>> : std::true_type {};
+	}
+
+	using internal::vec3a;
+	using internal::tile;
+	using internal::tile3;
+
+	// Returns element i of a tile quantity, e.g. lane(positions[0], 3) returns the 4th position as length3.
+	template <class Dimension, class T, size_t N>
+	constexpr detail::quantity<Dimension, detail::vec3<T>> lane(const detail::quantity<Dimension, tile3<T, N>>& x, size_t i)
+	{
+		return { Dimension(), value(x).get(i) };
+	}
+
+	template <class Dimension, class T, size_t N>
+	constexpr detail::quantity<Dimension, T> lane(const detail::quantity<Dimension, tile<T, N>>& x, size_t i)
+	{
+		return { Dimension(), value(x)[i] };
+	}
+
+	// Packs 3D quantities (AoS, e.g. a std::vector<length3>) into tiles of N (AoSoA), the last tile is padded with zeros.
+	template <size_t N = 8, class Container, class Q = detail::element_of_t<const Container>>
+	auto pack(const Container& in)
+	{
+		using tile_type = detail::quantity<typename Q::dimension_type, tile3<std::decay_t<decltype(value(std::declval<const Q&>()).x)>, N>>;
+		const span<const Q> x(in);
+		std::vector<tile_type> out((x.size() + N - 1) / N);
+		for (size_t i = 0; i < x.size(); i++)
+			value(out[i / N]).set(i % N, value(x[i]));
+		return out;
+	}
+
+	// Unpacks the first count elements of tiles (AoSoA) into 3D quantities (AoS).
+	template <class Container, class Q = detail::element_of_t<const Container>>
+	auto unpack(const Container& in, size_t count)
+	{
+		constexpr size_t N = Q::value_type::size;
+		const span<const Q> x(in);
+		assert(x.size() * N >= count);
+		std::vector<decltype(lane(x[0], 0))> out(count);
+		for (size_t i = 0; i < count; i++)
+			out[i] = lane(x[i / N], i % N);
+		return out;
+	}
+
+} // namespace SI
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/AoS_and_SoA (array of structures of arrays)
+// 2. https://www.intel.com/content/www/us/en/developer/articles/technical/memory-layout-transformations.html
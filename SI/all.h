@@ -7,4 +7,20 @@
 #include "literals.h"  // <-- convenient literals such as 100_m or 60_sec
 #include "formulas.h"  // <-- common formulas such as SI::formula::wavelength()
 #include "IO.h"        // <-- input/output functions such as SI::print()
+#include "export.h"    // <-- CSV and JSON writers such as SI::csv_writer
+#include "instrumentation.h" // <-- call counts and cycles of formulas and conversions such as SI::instrumentation::to_json()
+#include "checked.h"   // <-- checked math reporting NaN and infinities such as SI::set_fp_error_handler()
+#include "batch.h"     // <-- batched operations on arrays such as SI::convert()
+#include "fast_math.h" // <-- opt-in fast approximations such as SI::fast::sqrt()
+#include "aligned.h"   // <-- aligned and tiled 3D storage such as SI::tile3<SIdouble>
+#include "rotation.h"  // <-- 3x3 matrices and quaternions such as SI::rotate()
+#include "accumulator.h" // <-- compensated and reproducible sums such as SI::sum()
+#include "interval.h"  // <-- interval arithmetic for rigorous bounds such as SI::interval<SIdouble>
+#include "dual.h"      // <-- automatic differentiation such as SI::derivative()
+#include "montecarlo.h" // <-- Monte Carlo uncertainty propagation such as SI::monte_carlo::propagate()
+#include "atmosphere.h" // <-- the standard atmosphere such as SI::ISA::state_at()
+#include "ballistics.h" // <-- trajectories with drag such as SI::ballistics::fly_rk4()
+#include "orbits.h"    // <-- elliptic orbits such as SI::orbit::state_at()
+#include "nbody.h"     // <-- gravitational N-body simulations such as SI::nbody::simulation
+#include "spatial.h"   // <-- spatial indexes such as SI::spatial::kd_tree
 #include "tests.h"     // <-- unit tests at compile-time to verify everything
@@ -0,0 +1,146 @@
+// <SI/atmosphere.h> - the International Standard Atmosphere (ISA 1976), e.g. SI::ISA::state_at(10_km).speed_of_sound
+//                     (based on the 8 layers of datasets/ISA_1976_layers.csv, valid up to 86 km above MSL)
+#pragma once
+#include <cmath>
+#include <vector>
+#include <SI/batch.h>
+
+namespace SI { namespace ISA {
+
+	// the state of the atmosphere at some altitude
+	struct state
+	{
+		temperature air_temperature;
+		pressure air_pressure;
+		density air_density;
+		velocity speed_of_sound;
+	};
+
+	namespace detail
+	{
+		using lapse_rate_t = decltype(kelvins(1.0) / meters(1.0));
+
+		struct layer
+		{
+			length base_altitude; // geopotential
+			lapse_rate_t lapse_rate;
+			temperature base_temperature;
+			pressure base_pressure;
+		};
+
+		// NOTE: compared to the CSV file, the troposphere is based at MSL (instead of rounded values at -610 m), the mesopause
+		//       temperature continues the mesosphere, and all lapse rates are temperature change per altitude (the CSV signs are mixed)
+		constexpr layer layers[] = {
+			//  BASE ALTITUDE LAPSE RATE         BASE TEMPERATURE    BASE PRESSURE
+			{    0_m,   -6.5_K / 1_km,   celsius(15.0),     101325_Pa }, // troposphere (down to -610 m)
+			{  11_km,      0_K / 1_km,   celsius(-56.5),     22632_Pa }, // tropopause
+			{  20_km,      1_K / 1_km,   celsius(-56.5),    5474.9_Pa }, // stratosphere
+			{  32_km,    2.8_K / 1_km,   celsius(-44.5),    868.02_Pa }, // stratosphere
+			{  47_km,      0_K / 1_km,   celsius(-2.5),     110.91_Pa }, // stratopause
+			{  51_km,   -2.8_K / 1_km,   celsius(-2.5),     66.939_Pa }, // mesosphere
+			{  71_km,     -2_K / 1_km,   celsius(-58.5),    3.9564_Pa }, // mesosphere
+			{ 84.852_km,   0_K / 1_km,   celsius(-86.204),  0.3734_Pa }, // mesopause
+		};
+		constexpr size_t layer_count = sizeof(layers) / sizeof(layers[0]);
+
+		constexpr auto hydrostatic_constant = constant::g_n / constant::R_dry_air; // (g0 / R)
+		constexpr auto Earth_radius = 6356.766_km; // (as used by ISA 1976 for geopotential altitudes)
+
+		// Returns the index of the layer containing the geopotential altitude, without branches.
+		constexpr size_t layer_index(length geopotential_altitude)
+		{
+			size_t index = 0;
+			for (size_t i = 1; i < layer_count; i++)
+				index += (geopotential_altitude >= layers[i].base_altitude);
+			return index;
+		}
+	}
+
+	// Converts the geometric altitude above MSL into geopotential altitude.
+	constexpr length geopotential_altitude(length geometric_altitude)
+	{
+		return detail::Earth_radius * geometric_altitude / (detail::Earth_radius + geometric_altitude);
+	}
+
+	// Returns the state of the atmosphere at the given geometric altitude above MSL.
+	constexpr state state_at(length altitude)
+	{
+		const length H = geopotential_altitude(altitude);
+		const auto& layer = detail::layers[detail::layer_index(H)];
+		const length dH = H - layer.base_altitude;
+		const temperature T = layer.base_temperature + layer.lapse_rate * dH;
+		const dimensionless exponent = (layer.lapse_rate == 0_K / 1_km)
+			? -detail::hydrostatic_constant * dH / layer.base_temperature // (isothermal layer)
+			: -detail::hydrostatic_constant / layer.lapse_rate * constexpr_math::log(T / layer.base_temperature);
+		const pressure p = layer.base_pressure * constexpr_math::exp(exponent);
+		return { T, p, formula::density_of_dry_air(p, T), formula::speed_of_sound_in_air(T) };
+	}
+
+	// Returns the states of the atmosphere at the given geometric altitudes above MSL.
+	void state_at(span<const length> altitudes, span<state> states)
+	{
+		assert(states.size() >= altitudes.size());
+		for (size_t i = 0; i < altitudes.size(); i++)
+			states[i] = state_at(altitudes[i]);
+	}
+
+	// Returns the states of the atmosphere at the given geometric altitudes above MSL, multithreaded for very large batches.
+	void state_at(const parallel_t& policy, span<const length> altitudes, span<state> states)
+	{
+		assert(states.size() >= altitudes.size());
+		SI::detail::parallel_for(policy, altitudes.size(), [&](size_t begin, size_t end)
+		{
+			state_at(altitudes.subspan(begin, end - begin), states.subspan(begin, end - begin));
+		});
+	}
+
+	// A precomputed table of atmosphere states, linearly interpolated (faster than state_at(), but less exact).
+	class table
+	{
+	public:
+		explicit table(length step = 10_m, length min_altitude = -610_m, length max_altitude = 86_km)
+			: m_min_altitude(min_altitude), m_per_step(1.0 / step)
+		{
+			const size_t count = static_cast<size_t>((max_altitude - min_altitude) / step) + 2;
+			m_states.reserve(count);
+			for (size_t i = 0; i < count; i++)
+				m_states.push_back(state_at(min_altitude + static_cast<double>(i) * step));
+		}
+
+		// Returns the interpolated state at the given geometric altitude above MSL (clamped to the table range, NaN for NaN).
+		state operator()(length altitude) const
+		{
+			const double x = (altitude - m_min_altitude) * m_per_step;
+			const double position = std::fmin(std::fmax(x, 0.0), static_cast<double>(m_states.size() - 2)); // (fmax maps NaN to 0)
+			const size_t index = static_cast<size_t>(position);
+			const double t = std::isnan(x) ? x : position - static_cast<double>(index);
+			const state& a = m_states[index];
+			const state& b = m_states[index + 1];
+			return {
+				a.air_temperature + t * (b.air_temperature - a.air_temperature),
+				a.air_pressure + t * (b.air_pressure - a.air_pressure),
+				a.air_density + t * (b.air_density - a.air_density),
+				a.speed_of_sound + t * (b.speed_of_sound - a.speed_of_sound),
+			};
+		}
+
+		// Returns the interpolated states at the given geometric altitudes above MSL.
+		void operator()(span<const length> altitudes, span<state> states) const
+		{
+			assert(states.size() >= altitudes.size());
+			for (size_t i = 0; i < altitudes.size(); i++)
+				states[i] = operator()(altitudes[i]);
+		}
+
+	private:
+		std::vector<state> m_states;
+		length m_min_altitude;
+		per_length m_per_step;
+	};
+
+} } // namespace SI::ISA
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/International_Standard_Atmosphere
+// 2. https://ntrs.nasa.gov/citations/19770009539 (U.S. Standard Atmosphere, 1976)
@@ -0,0 +1,337 @@
+// <SI/ballistics.h> - trajectories of projectiles with drag, e.g. SI::ballistics::fly_rk4(start, bullet, environment, 1_ms)
+//                     (z is up, the air density is taken from the standard atmosphere by default)
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <SI/atmosphere.h>
+
+namespace SI { namespace ballistics {
+
+	struct projectile
+	{
+		SI::mass mass;
+		dimensionless drag_coefficient;
+		area reference_area; // (cross-sectional area)
+	};
+
+	struct environment
+	{
+		acceleration3 gravity = meters_per_second2(0.0, 0.0, -value(constant::g_n));
+		velocity3 wind = meters_per_second(0.0, 0.0, 0.0);
+		density air_density = 1.225_kg_per_m³; // (used when standard_atmosphere is false)
+		bool standard_atmosphere = true;      // air density by altitude from SI::ISA::state_at()
+	};
+
+	// a point of a trajectory
+	struct state
+	{
+		SI::time time;
+		length3 position;
+		velocity3 velocity;
+	};
+
+	using trajectory = std::vector<state>;
+
+	namespace detail
+	{
+		using area_per_mass = decltype(1_m² / 1_kg);
+
+		constexpr length altitude_of(const length3& position)
+		{
+			return meters(value(position).z);
+		}
+
+		// Returns the acceleration by gravity and drag, with drag_factor = drag coefficient * reference area / mass.
+		acceleration3 acceleration_of(area_per_mass drag_factor, const environment& env, const length3& position, const velocity3& velocity)
+		{
+			const density air_density = env.standard_atmosphere ? ISA::state_at(altitude_of(position)).air_density : env.air_density;
+			const velocity3 airspeed = velocity - env.wind;
+			// (formula::drag_in_fluid() per mass and direction, i.e. 0.5 * p * u² * cd * A / m along -u)
+			return env.gravity - (0.5 * air_density * drag_factor * norm(airspeed)) * airspeed;
+		}
+
+		area_per_mass drag_factor_of(const projectile& p)
+		{
+			return p.drag_coefficient * p.reference_area / p.mass;
+		}
+
+		state rk4_step(const state& s, area_per_mass k, const environment& env, SI::time dt)
+		{
+			const velocity3 v1 = s.velocity;
+			const acceleration3 a1 = acceleration_of(k, env, s.position, v1);
+			const velocity3 v2 = s.velocity + 0.5 * dt * a1;
+			const acceleration3 a2 = acceleration_of(k, env, s.position + 0.5 * dt * v1, v2);
+			const velocity3 v3 = s.velocity + 0.5 * dt * a2;
+			const acceleration3 a3 = acceleration_of(k, env, s.position + 0.5 * dt * v2, v3);
+			const velocity3 v4 = s.velocity + dt * a3;
+			const acceleration3 a4 = acceleration_of(k, env, s.position + dt * v3, v4);
+			return { s.time + dt, s.position + (dt / 6.0) * (v1 + 2.0 * v2 + 2.0 * v3 + v4), s.velocity + (dt / 6.0) * (a1 + 2.0 * a2 + 2.0 * a3 + a4) };
+		}
+
+		// Tries a Dormand-Prince 5(4) step, returns the error estimate relative to the tolerance (accepted if <= 1).
+		double rk45_step(const state& s, area_per_mass k, const environment& env, SI::time dt, length tolerance, state& result)
+		{
+			const velocity3 v1 = s.velocity;
+			const acceleration3 a1 = acceleration_of(k, env, s.position, v1);
+			const velocity3 v2 = s.velocity + dt * (1/5. * a1);
+			const acceleration3 a2 = acceleration_of(k, env, s.position + dt * (1/5. * v1), v2);
+			const velocity3 v3 = s.velocity + dt * (3/40. * a1 + 9/40. * a2);
+			const acceleration3 a3 = acceleration_of(k, env, s.position + dt * (3/40. * v1 + 9/40. * v2), v3);
+			const velocity3 v4 = s.velocity + dt * (44/45. * a1 - 56/15. * a2 + 32/9. * a3);
+			const acceleration3 a4 = acceleration_of(k, env, s.position + dt * (44/45. * v1 - 56/15. * v2 + 32/9. * v3), v4);
+			const velocity3 v5 = s.velocity + dt * (19372/6561. * a1 - 25360/2187. * a2 + 64448/6561. * a3 - 212/729. * a4);
+			const acceleration3 a5 = acceleration_of(k, env, s.position + dt * (19372/6561. * v1 - 25360/2187. * v2 + 64448/6561. * v3 - 212/729. * v4), v5);
+			const velocity3 v6 = s.velocity + dt * (9017/3168. * a1 - 355/33. * a2 + 46732/5247. * a3 + 49/176. * a4 - 5103/18656. * a5);
+			const acceleration3 a6 = acceleration_of(k, env, s.position + dt * (9017/3168. * v1 - 355/33. * v2 + 46732/5247. * v3 + 49/176. * v4 - 5103/18656. * v5), v6);
+			const velocity3 v7 = s.velocity + dt * (35/384. * a1 + 500/1113. * a3 + 125/192. * a4 - 2187/6784. * a5 + 11/84. * a6);
+			const length3 p7 = s.position + dt * (35/384. * v1 + 500/1113. * v3 + 125/192. * v4 - 2187/6784. * v5 + 11/84. * v6);
+			const acceleration3 a7 = acceleration_of(k, env, p7, v7);
+			result = { s.time + dt, p7, v7 };
+
+			// difference to the embedded 4th order solution
+			const length position_error = norm(dt * (71/57600. * v1 - 71/16695. * v3 + 71/1920. * v4 - 17253/339200. * v5 + 22/525. * v6 - 1/40. * v7));
+			const velocity velocity_error = norm(dt * (71/57600. * a1 - 71/16695. * a3 + 71/1920. * a4 - 17253/339200. * a5 + 22/525. * a6 - 1/40. * a7));
+			return std::max(position_error / tolerance, velocity_error * 1_s / tolerance);
+		}
+
+		constexpr SI::time min_step = 1_us; // (of fly_rk45() when retrying to hit the ground)
+
+		// Appends the last state, interpolated to the ground (altitude 0) if it's below.
+		void land(trajectory& path, const state& previous, const state& next)
+		{
+			const double t = altitude_of(previous.position) / (altitude_of(previous.position) - altitude_of(next.position));
+			path.push_back({ previous.time + t * (next.time - previous.time), previous.position + t * (next.position - previous.position),
+				previous.velocity + t * (next.velocity - previous.velocity) });
+		}
+	}
+
+	// Calculates the acceleration of the projectile by gravity and drag.
+	acceleration3 acceleration_of(const projectile& p, const environment& env, const length3& position, const velocity3& velocity)
+	{
+		return detail::acceleration_of(detail::drag_factor_of(p), env, position, velocity);
+	}
+
+	// Integrates a single step with the classic Runge-Kutta method (RK4).
+	state rk4_step(const state& s, const projectile& p, const environment& env, SI::time dt)
+	{
+		return detail::rk4_step(s, detail::drag_factor_of(p), env, dt);
+	}
+
+	// Calculates the trajectory with fixed time steps (RK4) until the projectile hits the ground or the max time elapsed.
+	trajectory fly_rk4(const state& start, const projectile& p, const environment& env, SI::time dt, SI::time max_time = 1_h)
+	{
+		const auto k = detail::drag_factor_of(p);
+		trajectory path{ start };
+		for (state s = start; s.time - start.time < max_time; )
+		{
+			const state next = detail::rk4_step(s, k, env, dt);
+			if (detail::altitude_of(next.position) < 0_m)
+			{
+				detail::land(path, s, next);
+				break;
+			}
+			path.push_back(s = next);
+		}
+		return path;
+	}
+
+	// Calculates the trajectory with adaptive time steps (Dormand-Prince RK45) until the projectile hits the ground or the max time elapsed.
+	trajectory fly_rk45(const state& start, const projectile& p, const environment& env, length tolerance = 1_mm, SI::time max_time = 1_h)
+	{
+		const auto k = detail::drag_factor_of(p);
+		trajectory path{ start };
+		SI::time dt = 10_ms;
+		for (state s = start; s.time - start.time < max_time; )
+		{
+			state next;
+			const double error = detail::rk45_step(s, k, env, dt, tolerance, next);
+			const double factor = error > 0 ? clamp(0.9 * constexpr_math::pow(1.0 / error, 0.2), 0.2, 5.0) : 5.0;
+			if (error > 1)
+			{
+				dt *= factor; // (rejected, retry with a smaller step)
+				continue;
+			}
+			if (detail::altitude_of(next.position) < -tolerance)
+			{
+				if (detail::altitude_of(s.position) <= 0_m)
+					break; // (on the ground and heading down, so it has landed already)
+				const double t = detail::altitude_of(s.position) / (detail::altitude_of(s.position) - detail::altitude_of(next.position));
+				if (t * dt < detail::min_step)
+				{
+					detail::land(path, s, next); // (too close to the ground for a smaller step)
+					break;
+				}
+				dt *= t;
+				continue; // (below ground, retry with the step estimated to hit it)
+			}
+			if (detail::altitude_of(next.position) < 0_m)
+			{
+				detail::land(path, s, next);
+				break;
+			}
+			path.push_back(s = next);
+			dt *= factor;
+		}
+		return path;
+	}
+
+	namespace detail
+	{
+		// three SoA arrays of raw SI values, e.g. the positions of all projectiles in flight
+		struct lanes3
+		{
+			std::vector<SIdouble> x, y, z;
+
+			void resize(size_t count) { x.resize(count), y.resize(count), z.resize(count); }
+		};
+
+		// the projectiles still in flight as SoA arrays (landed ones are removed by moving the last one into their lane)
+		struct flight
+		{
+			lanes3 position, velocity;
+			std::vector<SIdouble> drag_factor;
+			std::vector<size_t> index; // (of the projectile)
+
+			// the scratch arrays of rk4_step() (sized once, so the steps don't allocate, removing lanes leaves them as is)
+			std::vector<SIdouble> air_density;
+			lanes3 p, v, a, sum_v, sum_a;
+
+			size_t size() const { return index.size(); }
+
+			void resize(size_t count)
+			{
+				position.resize(count), velocity.resize(count), drag_factor.resize(count), index.resize(count), air_density.resize(count);
+				for (auto* l : { &p, &v, &a, &sum_v, &sum_a })
+					l->resize(count);
+			}
+
+			void remove(size_t lane)
+			{
+				for (auto* array : { &position.x, &position.y, &position.z, &velocity.x, &velocity.y, &velocity.z, &drag_factor })
+				{
+					(*array)[lane] = array->back();
+					array->pop_back();
+				}
+				index[lane] = index.back();
+				index.pop_back();
+			}
+		};
+
+		// Calculates the accelerations by gravity and drag of all lanes, like acceleration_of() (the loop vectorizes,
+		// the air densities of the standard atmosphere are looked up before).
+		void accelerations(const environment& env, const flight& f, const lanes3& p, const lanes3& v, std::vector<SIdouble>& air_density, lanes3& a)
+		{
+			const size_t n = f.size();
+			if (env.standard_atmosphere)
+				for (size_t i = 0; i < n; i++)
+					air_density[i] = value(ISA::state_at(meters(p.z[i])).air_density);
+			else
+				std::fill(air_density.begin(), air_density.begin() + n, value(env.air_density));
+
+			const auto g = value(env.gravity), wind = value(env.wind);
+			for (size_t i = 0; i < n; i++)
+			{
+				const SIdouble ux = v.x[i] - wind.x, uy = v.y[i] - wind.y, uz = v.z[i] - wind.z;
+				const SIdouble c = 0.5 * air_density[i] * f.drag_factor[i] * std::sqrt(ux * ux + uy * uy + uz * uz);
+				a.x[i] = g.x - c * ux, a.y[i] = g.y - c * uy, a.z[i] = g.z - c * uz;
+			}
+		}
+
+		// result = base + h * derivative (for all lanes)
+		void step(const lanes3& base, SIdouble h, const lanes3& derivative, size_t n, lanes3& result)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				result.x[i] = base.x[i] + h * derivative.x[i];
+				result.y[i] = base.y[i] + h * derivative.y[i];
+				result.z[i] = base.z[i] + h * derivative.z[i];
+			}
+		}
+
+		// to = from (for all lanes)
+		void assign(lanes3& to, const lanes3& from, size_t n)
+		{
+			std::copy_n(from.x.begin(), n, to.x.begin());
+			std::copy_n(from.y.begin(), n, to.y.begin());
+			std::copy_n(from.z.begin(), n, to.z.begin());
+		}
+
+		// sum += weight * x (for all lanes)
+		void accumulate(lanes3& sum, SIdouble weight, const lanes3& x, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				sum.x[i] += weight * x.x[i];
+				sum.y[i] += weight * x.y[i];
+				sum.z[i] += weight * x.z[i];
+			}
+		}
+
+		// Integrates a step of all projectiles in flight with the classic Runge-Kutta method (RK4), like rk4_step().
+		void rk4_step(flight& f, const environment& env, SIdouble dt)
+		{
+			const size_t n = f.size();
+			lanes3 &p = f.p, &v = f.v, &a = f.a, &sum_v = f.sum_v, &sum_a = f.sum_a;
+
+			accelerations(env, f, f.position, f.velocity, f.air_density, a); // (stage 1)
+			assign(sum_v, f.velocity, n), assign(sum_a, a, n);
+			const SIdouble h[] = { dt / 2, dt / 2, dt }, weight[] = { 2, 2, 1 };
+			for (int stage = 0; stage < 3; stage++) // (stages 2 to 4, from the velocities v and accelerations a of the stage before)
+			{
+				step(f.position, h[stage], stage == 0 ? f.velocity : v, n, p);
+				step(f.velocity, h[stage], a, n, v);
+				accelerations(env, f, p, v, f.air_density, a);
+				accumulate(sum_v, weight[stage], v, n);
+				accumulate(sum_a, weight[stage], a, n);
+			}
+			step(f.position, dt / 6, sum_v, n, f.position);
+			step(f.velocity, dt / 6, sum_a, n, f.velocity);
+		}
+	}
+
+	// Calculates the trajectories of many projectiles with fixed time steps (RK4) until all hit the ground. All projectiles
+	// in flight step at once on SoA arrays (see detail::rk4_step()), landed ones are removed from them.
+	std::vector<trajectory> fly_rk4(span<const state> starts, span<const projectile> projectiles, const environment& env, SI::time dt, SI::time max_time = 1_h)
+	{
+		assert(projectiles.size() >= starts.size());
+		const size_t count = starts.size();
+		std::vector<trajectory> paths(count);
+		detail::flight f;
+		f.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			const auto p = value(starts[i].position), v = value(starts[i].velocity);
+			f.position.x[i] = p.x, f.position.y[i] = p.y, f.position.z[i] = p.z;
+			f.velocity.x[i] = v.x, f.velocity.y[i] = v.y, f.velocity.z[i] = v.z;
+			f.drag_factor[i] = value(detail::drag_factor_of(projectiles[i]));
+			f.index[i] = i;
+			paths[i].push_back(starts[i]);
+		}
+		for (SI::time t = 0_s; f.size() > 0 && t < max_time; t += dt)
+		{
+			detail::rk4_step(f, env, value(dt));
+			for (size_t lane = f.size(); lane-- > 0; ) // (backwards, as removing moves the last lane)
+			{
+				const size_t i = f.index[lane];
+				const state next = { starts[i].time + t + dt, meters(f.position.x[lane], f.position.y[lane], f.position.z[lane]),
+					meters_per_second(f.velocity.x[lane], f.velocity.y[lane], f.velocity.z[lane]) };
+				if (f.position.z[lane] < 0)
+				{
+					detail::land(paths[i], paths[i].back(), next);
+					f.remove(lane);
+				}
+				else
+					paths[i].push_back(next);
+			}
+		}
+		return paths;
+	}
+
+} } // namespace SI::ballistics
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods
+// 2. https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method
+// 3. https://en.wikipedia.org/wiki/Drag_(physics)
@@ -0,0 +1,510 @@
+// <SI/batch.h> - batched operations on arrays of SI datatypes, e.g. convert(raw_feet, feet, altitudes) or formula::kinetic_energy(masses, velocities, energies)
+//                (the loops are written to be vectorized by the compiler, the SI::parallel variants split them across threads)
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <SI/checked.h>
+#include <SI/instrumentation.h>
+#include <SI/formulas.h>
+
+namespace SI
+{
+	// a view onto contiguous elements (a subset of C++20's std::span)
+	template <class T>
+	class span
+	{
+	public:
+		constexpr span() = default;
+		constexpr span(T* data, size_t size) : m_data(data), m_size(size) {}
+
+		template <class Container, class = std::enable_if_t<std::is_convertible_v<decltype(std::data(std::declval<Container&>())), T*>>>
+		constexpr span(Container& container) : m_data(std::data(container)), m_size(std::size(container)) {} // NOLINT(google-explicit-constructor)
+
+		constexpr T* data() const { return m_data; }
+		constexpr size_t size() const { return m_size; }
+		constexpr bool empty() const { return m_size == 0; }
+		constexpr T& operator[](size_t index) const { return m_data[index]; }
+		constexpr T* begin() const { return m_data; }
+		constexpr T* end() const { return m_data + m_size; }
+		constexpr span subspan(size_t offset, size_t count) const { return { m_data + offset, count }; }
+
+	private:
+		T* m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	// tag to select the multithreaded variant of batched functions, e.g. convert(parallel, ...)
+	struct parallel_t
+	{
+		size_t min_batch = 1 << 16; // below this element count per thread it's faster to stay single-threaded
+	};
+	inline constexpr parallel_t parallel;
+
+	namespace detail
+	{
+		// Calls function(begin, end) on contiguous chunks of [0, count) on all hardware threads.
+		template <class Function>
+		void parallel_for(const parallel_t& policy, size_t count, Function&& function)
+		{
+			const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+			const size_t threads = std::min(max_threads, count / std::max<size_t>(1, policy.min_batch));
+			if (threads <= 1)
+			{
+				function(size_t(0), count);
+				return;
+			}
+			const size_t chunk = (count + threads - 1) / threads;
+			std::vector<std::thread> workers;
+			workers.reserve(threads - 1);
+#ifdef SI_CHECKED_MATH
+			// (the floating-point exception flags are per thread, so the workers pass theirs on to this thread)
+			std::vector<int> raised(threads - 1);
+			for (size_t begin = chunk, worker = 0; begin < count; begin += chunk, worker++)
+				workers.emplace_back([&function, &raised, worker, begin, end = std::min(count, begin + chunk)]
+				{
+					std::feclearexcept(checked_fp_exceptions);
+					function(begin, end);
+					raised[worker] = std::fetestexcept(checked_fp_exceptions);
+				});
+			function(size_t(0), chunk);
+			for (size_t worker = 0; worker < workers.size(); worker++)
+			{
+				workers[worker].join();
+				if (raised[worker] != 0)
+					std::feraiseexcept(raised[worker]);
+			}
+#else
+			for (size_t begin = chunk; begin < count; begin += chunk)
+				workers.emplace_back([&function, begin, end = std::min(count, begin + chunk)] { function(begin, end); });
+			function(size_t(0), chunk);
+			for (auto& worker : workers)
+				worker.join();
+#endif
+		}
+
+		// the conversion of a unit as scale and offset: SI value = value * factor + offset
+		template <class Ratio> struct affine
+		{
+			static constexpr SIdouble factor = Ratio::factor;
+			static constexpr SIdouble offset = 0;
+		};
+		template <> struct affine<tag_celsius>
+		{
+			static constexpr SIdouble factor = 1;
+			static constexpr SIdouble offset = 273.15;
+		};
+		template <> struct affine<tag_fahrenheit>
+		{
+			static constexpr SIdouble factor = 5. / 9;
+			static constexpr SIdouble offset = 459.67 * 5. / 9;
+		};
+
+		template <class Dimension, class Ratio>
+		void convert_from(const SIdouble* in, quantity<Dimension, SIdouble>* out, size_t count)
+		{
+			constexpr SIdouble factor = affine<Ratio>::factor, offset = affine<Ratio>::offset;
+			for (size_t i = 0; i < count; i++)
+			{
+				if constexpr (offset == 0)
+					value(out[i]) = in[i] * factor;
+				else
+					value(out[i]) = in[i] * factor + offset; // (a multiply and an add, fused into an FMA only with -ffp-contract=fast and an -march that has one)
+			}
+		}
+
+		template <class Dimension, class Ratio>
+		void convert_to(const quantity<Dimension, SIdouble>* in, SIdouble* out, size_t count)
+		{
+			constexpr SIdouble factor = 1 / affine<Ratio>::factor, offset = -affine<Ratio>::offset / affine<Ratio>::factor;
+			for (size_t i = 0; i < count; i++)
+			{
+				if constexpr (offset == 0)
+					out[i] = value(in[i]) * factor;
+				else
+					out[i] = value(in[i]) * factor + offset;
+			}
+		}
+
+		template <class Function> struct function_traits;
+		template <class R, class... Args> struct function_traits<R(*)(Args...)>
+		{
+			using result = R;
+			using arguments = std::tuple<Args...>;
+		};
+
+		// a single value used for all elements of a batch
+		template <class T> struct broadcast
+		{
+			T value;
+			constexpr const T& operator[](size_t) const { return value; }
+		};
+
+		// batch inputs are either spans of the argument type or single values (broadcasted)
+		template <class T, class Arg>
+		constexpr bool is_batch_input_v = std::is_convertible_v<Arg, T> || std::is_constructible_v<span<const T>, Arg>;
+
+		template <class T, class Arg>
+		auto batch_input(Arg& arg)
+		{
+			if constexpr (std::is_convertible_v<Arg&, T>)
+				return broadcast<T>{ arg };
+			else
+				return span<const T>(arg);
+		}
+
+		template <class T> size_t batch_size(const span<const T>& input, size_t count) { assert(input.size() == count || count == size_t(-1)); return std::min(count, input.size()); }
+		template <class T> size_t batch_size(const broadcast<T>&, size_t count) { return count; }
+
+		template <class Traits, class Args, size_t... I>
+		constexpr bool is_batch_call(std::index_sequence<I...>)
+		{
+			return (is_batch_input_v<std::tuple_element_t<I, typename Traits::arguments>, std::tuple_element_t<I, Args>&> && ...)
+				&& std::is_constructible_v<span<typename Traits::result>, std::tuple_element_t<sizeof...(I), Args>&>;
+		}
+
+		// checks whether the arguments are the batch inputs of Function followed by the output span
+		template <auto Function, class... Args>
+		constexpr bool is_batch_call()
+		{
+			using traits = function_traits<decltype(Function)>;
+			constexpr size_t arity = std::tuple_size_v<typename traits::arguments>;
+			if constexpr (sizeof...(Args) != arity + 1)
+				return false;
+			else
+				return is_batch_call<traits, std::tuple<std::remove_reference_t<Args>...>>(std::make_index_sequence<arity>{});
+		}
+
+		template <auto Function, class R, class... Inputs>
+		void batch_loop(R* out, size_t begin, size_t end, Inputs... in)
+		{
+			for (size_t i = begin; i < end; i++)
+				out[i] = Function(in[i]...);
+		}
+
+		// Calls Function for all elements of the batch inputs and writes the results into the output span (the last argument).
+		template <auto Function, class... Args, size_t... I>
+		void batch_call([[maybe_unused]] const char* name, const parallel_t* policy, std::index_sequence<I...>, Args&... args)
+		{
+			using traits = function_traits<decltype(Function)>;
+			SI_CHECK_FP(name, typename traits::arguments);
+			auto arguments = std::tie(args...);
+			span<typename traits::result> out(std::get<sizeof...(I)>(arguments));
+			const auto inputs = std::make_tuple(batch_input<std::tuple_element_t<I, typename traits::arguments>>(std::get<I>(arguments))...);
+			size_t count = size_t(-1);
+			((count = batch_size(std::get<I>(inputs), count)), ...);
+			if (count == size_t(-1))
+				count = out.size(); // (single values only)
+			assert(out.size() >= count);
+			SI_PROFILE_BATCH(name, count); // (once per batch, the formula isn't counted per element)
+			const auto loop = [&](size_t begin, size_t end)
+			{
+				SI_UNPROFILED_SCOPE();
+				batch_loop<Function>(out.data(), begin, end, std::get<I>(inputs)...);
+			};
+			if (policy != nullptr)
+				parallel_for(*policy, count, loop);
+			else
+				loop(0, count);
+		}
+
+		template <auto Function, class... Args>
+		void batch_call([[maybe_unused]] const char* name, const parallel_t* policy, Args&... args)
+		{
+			batch_call<Function>(name, policy, std::make_index_sequence<sizeof...(Args) - 1>{}, args...);
+		}
+	}
+
+	// Converts raw values given in the unit (e.g. in feet, knots, or °F) into SI datatypes.
+	template <class Dimension, class Ratio>
+	void convert(span<const SIdouble> in, detail::unit<Dimension, Ratio>, span<detail::quantity<detail::identity_t<Dimension>, SIdouble>> out)
+	{
+		assert(out.size() >= in.size());
+		SI_CHECK_FP("convert", detail::quantity<detail::identity_t<Dimension>, SIdouble>);
+		detail::convert_from<Dimension, Ratio>(in.data(), out.data(), in.size());
+	}
+
+	// Converts SI datatypes into raw values given in the unit (e.g. in feet, knots, or °F).
+	template <class Dimension, class Ratio>
+	void convert(span<const detail::quantity<detail::identity_t<Dimension>, SIdouble>> in, detail::unit<Dimension, Ratio>, span<SIdouble> out)
+	{
+		assert(out.size() >= in.size());
+		SI_CHECK_FP("convert", detail::quantity<detail::identity_t<Dimension>, SIdouble>);
+		detail::convert_to<Dimension, Ratio>(in.data(), out.data(), in.size());
+	}
+
+	// Converts raw values given in the unit into SI datatypes, multithreaded for very large buffers.
+	template <class Dimension, class Ratio>
+	void convert(const parallel_t& policy, span<const SIdouble> in, detail::unit<Dimension, Ratio>, span<detail::quantity<detail::identity_t<Dimension>, SIdouble>> out)
+	{
+		assert(out.size() >= in.size());
+		SI_CHECK_FP("convert", detail::quantity<detail::identity_t<Dimension>, SIdouble>);
+		detail::parallel_for(policy, in.size(), [&](size_t begin, size_t end)
+		{
+			detail::convert_from<Dimension, Ratio>(in.data() + begin, out.data() + begin, end - begin);
+		});
+	}
+
+	// Converts SI datatypes into raw values given in the unit, multithreaded for very large buffers.
+	template <class Dimension, class Ratio>
+	void convert(const parallel_t& policy, span<const detail::quantity<detail::identity_t<Dimension>, SIdouble>> in, detail::unit<Dimension, Ratio>, span<SIdouble> out)
+	{
+		assert(out.size() >= in.size());
+		SI_CHECK_FP("convert", detail::quantity<detail::identity_t<Dimension>, SIdouble>);
+		detail::parallel_for(policy, in.size(), [&](size_t begin, size_t end)
+		{
+			detail::convert_to<Dimension, Ratio>(in.data() + begin, out.data() + begin, end - begin);
+		});
+	}
+
+	namespace detail
+	{
+		// sin(r) and cos(r) for r in [-π/4, π/4] by the minimax polynomials of fdlibm (below 1 ulp)
+		constexpr SIdouble sin_kernel(SIdouble r)
+		{
+			const SIdouble z = r * r;
+			return r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04
+				+ z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+		}
+
+		constexpr SIdouble cos_kernel(SIdouble r)
+		{
+			const SIdouble z = r * r;
+			return 1 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05
+				+ z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+		}
+
+		// returns 1 for x >= +0 and 0 for x <= -0, by arithmetic instead of a comparison
+		constexpr SIdouble step(SIdouble x)
+		{
+			return 0.5 + 0.5 * std::copysign(1.0, x);
+		}
+
+		// returns a for weight 1 and b for weight 0 (exactly, if both are finite). Unlike a ?: on the results of
+		// arithmetic, the compiler doesn't need to keep this as a branch (in case the arithmetic traps).
+		constexpr SIdouble blend(SIdouble weight, SIdouble a, SIdouble b)
+		{
+			return a * weight + b * (1 - weight);
+		}
+
+		// returns sin(x) from sin(r), cos(r) and the quadrant (q) of x = q·π/2 + r, for cos(x) pass q + 1
+		constexpr SIdouble sin_of_quadrant(SIdouble sin_r, SIdouble cos_r, int32_t q)
+		{
+			const SIdouble y = (q & 1) ? cos_r : sin_r;
+			return (q & 2) ? -y : y;
+		}
+
+		constexpr SIdouble trig_limit = 1e5; // (above, the range reduction loses accuracy and <cmath> takes over)
+
+		// Calculates sines and cosines in branch-free loops the compiler vectorizes (Cody-Waite range reduction
+		// x = k·π/2 + r with π/2 split into three parts, then the polynomials above, within 2.5 ulp).
+		inline void sincos(const angle* in, SIdouble* sines, SIdouble* cosines, size_t count)
+		{
+			constexpr SIdouble two_over_pi = 6.36619772367581382433e-01, round = 0x1.8p52;
+			constexpr SIdouble pio2_1 = 1.57079632673412561417e+00, pio2_2 = 6.07710050630396597660e-11, pio2_2t = 2.02226624879595063154e-21;
+			for (size_t i = 0; i < count; i++)
+			{
+				const SIdouble x = in[i];
+				const SIdouble k = (x * two_over_pi + round) - round; // (rounded to the nearest integer)
+				const SIdouble r = ((x - k * pio2_1) - k * pio2_2) - k * pio2_2t;
+				const SIdouble sin_r = sin_kernel(r), cos_r = cos_kernel(r);
+				const int32_t q = static_cast<int32_t>(std::islessequal(std::fabs(k), trig_limit) ? k : 0); // (others follow below)
+				sines[i] = sin_of_quadrant(sin_r, cos_r, q);
+				cosines[i] = sin_of_quadrant(sin_r, cos_r, q + 1);
+			}
+			for (size_t i = 0; i < count; i++) // (rarely: huge angles, infinities, NaN)
+			{
+				const SIdouble x = in[i];
+				if (x >= -trig_limit && x <= trig_limit)
+					continue;
+				sines[i] = std::sin(x);
+				cosines[i] = std::cos(x);
+			}
+		}
+
+		// Calculates either sines or cosines (both are needed in the loop above, or else the compiler would keep
+		// the polynomial of the other one as a branch, which doesn't vectorize).
+		template <bool Sin>
+		void sin_or_cos(const angle* in, SIdouble* out, size_t count)
+		{
+			constexpr size_t chunk = 256;
+			SIdouble unused[chunk];
+			for (size_t begin = 0; begin < count; begin += chunk)
+			{
+				const size_t n = std::min(chunk, count - begin);
+				if constexpr (Sin)
+					sincos(in + begin, out + begin, unused, n);
+				else
+					sincos(in + begin, unused, out + begin, n);
+			}
+		}
+
+		// Calculates atan2(y, x) in branch-free loops the compiler vectorizes (reduction to [0, 0.66] and the
+		// rational approximation of Cephes, within 1.5 ulp).
+		inline void atan2(const length* y, const length* x, angle* out, size_t count)
+		{
+			constexpr SIdouble pi_4 = 7.85398163397448278999e-01, pi_2 = 1.57079632679489655800e+00, pi = 3.14159265358979311600e+00;
+			constexpr SIdouble pi_4_lo = 3.06161699786838301793e-17, pi_2_lo = 6.12323399573676603587e-17, pi_lo = 1.22464679914735320717e-16;
+			constexpr SIdouble inf = std::numeric_limits<SIdouble>::infinity();
+			for (size_t i = 0; i < count; i++)
+			{
+				// (infinities and y = 0 become 1, so no lane raises floating-point exceptions on valid input, e.g. 0 / 0 or
+				//  inf * 0 in a blend, the loop below overwrites their results)
+				const SIdouble fabs_y = std::fabs(value(y[i])), fabs_x = std::fabs(value(x[i]));
+				const SIdouble ay = (fabs_y > 0) & (fabs_y < inf) ? fabs_y : 1, ax = fabs_x < inf ? fabs_x : 1;
+				const SIdouble steep = step(ay - ax); // (then atan2 = π/2 - atan(ax / ay))
+				const SIdouble hi = blend(steep, ay, ax), lo = blend(steep, ax, ay);
+				const SIdouble upper = step(lo - 0.66 * hi); // (then atan(t) = π/4 + atan((t - 1) / (t + 1)))
+				const SIdouble ratio = lo / hi, t = blend(upper, (ratio - 1) / (ratio + 1), ratio), z = t * t;
+				const SIdouble P = (((-8.750608600031904122785e-01 * z - 1.615753718733365076637e+01) * z - 7.500855792314704667340e+01) * z
+					- 1.228866684490136173410e+02) * z - 6.485021904942025371773e+01;
+				const SIdouble Q = ((((z + 2.485846490142306297962e+01) * z + 1.650270098316988542046e+02) * z + 4.328810604912902668951e+02) * z
+					+ 4.853903996359136964868e+02) * z + 1.945506571482613964425e+02;
+				SIdouble a = t + t * z * P / Q;
+				a = blend(upper, pi_4 + (a + pi_4_lo), a);
+				a = blend(steep, pi_2 - a + pi_2_lo, a);
+				a = blend(1 - step(value(x[i])), pi - a + pi_lo, a);
+				out[i] = std::copysign(a, value(y[i]));
+			}
+			for (size_t i = 0; i < count; i++) // (rarely: zeros, infinities, NaN)
+			{
+				if (value(y[i]) == 0 || !(std::fabs(value(y[i])) < inf) || !(std::fabs(value(x[i])) < inf))
+					out[i] = std::atan2(value(y[i]), value(x[i]));
+			}
+		}
+	}
+
+	// Calculates the sines of many angles (vectorized, see detail::sincos()).
+	inline void sin(span<const angle> angles, span<dimensionless> sines)
+	{
+		assert(sines.size() >= angles.size());
+		SI_CHECK_FP("sin", angle);
+		detail::sin_or_cos<true>(angles.data(), sines.data(), angles.size());
+	}
+
+	// Calculates the cosines of many angles (vectorized, see detail::sincos()).
+	inline void cos(span<const angle> angles, span<dimensionless> cosines)
+	{
+		assert(cosines.size() >= angles.size());
+		SI_CHECK_FP("cos", angle);
+		detail::sin_or_cos<false>(angles.data(), cosines.data(), angles.size());
+	}
+
+	// Calculates the sines and cosines of many angles at once (sharing the range reduction).
+	inline void sincos(span<const angle> angles, span<dimensionless> sines, span<dimensionless> cosines)
+	{
+		assert(sines.size() >= angles.size() && cosines.size() >= angles.size());
+		SI_CHECK_FP("sincos", angle);
+		detail::sincos(angles.data(), sines.data(), cosines.data(), angles.size());
+	}
+
+	// Calculates the sines and cosines of many angles at once, multithreaded for very large batches.
+	inline void sincos(const parallel_t& policy, span<const angle> angles, span<dimensionless> sines, span<dimensionless> cosines)
+	{
+		assert(sines.size() >= angles.size() && cosines.size() >= angles.size());
+		SI_CHECK_FP("sincos", angle);
+		detail::parallel_for(policy, angles.size(), [&](size_t begin, size_t end)
+		{
+			detail::sincos(angles.data() + begin, sines.data() + begin, cosines.data() + begin, end - begin);
+		});
+	}
+
+	// Calculates the angles of many points (x, y), like SI::atan2(y, x) (vectorized, see detail::atan2()).
+	inline void atan2(span<const length> y, span<const length> x, span<angle> angles)
+	{
+		assert(x.size() >= y.size() && angles.size() >= y.size());
+		SI_CHECK_FP("atan2", length, length);
+		detail::atan2(y.data(), x.data(), angles.data(), y.size());
+	}
+
+	namespace detail
+	{
+		template <class Container> using element_of_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::data(std::declval<Container&>()))>>;
+	}
+
+	// Raises many quantities to the power of Exponent, like SI::pow<Exponent>(), e.g. pow<3>(edges, volumes) (vectorized,
+	// multiplications only).
+	template <long Exponent, class In, class Out, class T = detail::element_of_t<const In>>
+	void pow(const In& in, Out& out)
+	{
+		const span<const T> x(in);
+		const span<decltype(pow<Exponent>(std::declval<T>()))> y(out);
+		assert(y.size() >= x.size());
+		SI_CHECK_FP("pow", T);
+		for (size_t i = 0; i < x.size(); i++)
+			y[i] = pow<Exponent>(x[i]);
+	}
+
+	// Takes the Degree-th roots of many quantities, like SI::root<Degree>(), e.g. root<3>(volumes, edges) (for degree 2
+	// the loop vectorizes with -fno-math-errno, else it's a sqrt instruction per value, for degree 3 a cbrt call).
+	template <long Degree, class In, class Out, class T = detail::element_of_t<const In>>
+	void root(const In& in, Out& out)
+	{
+		const span<const T> x(in);
+		const span<decltype(root<Degree>(std::declval<T>()))> y(out);
+		assert(y.size() >= x.size());
+		SI_CHECK_FP("root", T);
+		for (size_t i = 0; i < x.size(); i++)
+			y[i] = root<Degree>(x[i]);
+	}
+
+	// Takes the square roots of many quantities, like SI::sqrt(), e.g. sqrt(areas, lengths).
+	template <class In, class Out, class T = detail::element_of_t<const In>>
+	void sqrt(const In& in, Out& out)
+	{
+		root<2>(in, out);
+	}
+} // namespace SI
+
+// Batched overloads of all formulas, taking spans (or single values) for the inputs and a span for the results:
+//   formula::kinetic_energy(masses, velocities, energies);
+//   formula::braking_distance(SI::parallel, speeds, 0_km_per_h, 8_m_per_s², distances);
+#define BATCH(_name) \
+	namespace batched { inline constexpr auto _name = &formula::_name<SIdouble>; } \
+	template <class... Args, class = std::enable_if_t<detail::is_batch_call<batched::_name, Args...>()>> \
+	void _name(Args&&... args) { detail::batch_call<batched::_name>("formula::" #_name, nullptr, args...); } \
+	template <class... Args, class = std::enable_if_t<detail::is_batch_call<batched::_name, Args...>()>> \
+	void _name(const parallel_t& policy, Args&&... args) { detail::batch_call<batched::_name>("formula::" #_name, &policy, args...); }
+
+namespace SI { namespace formula {
+
+// 2D
+BATCH(hypotenuse_of_triangle) BATCH(angle1_in_triangle) BATCH(angle2_in_triangle) BATCH(angle3_in_triangle) BATCH(area_of_triangle)
+BATCH(perimeter_of_rectangle) BATCH(area_of_rectangle) BATCH(perimeter_of_square) BATCH(area_of_square) BATCH(area_of_trapezoid)
+BATCH(circumference_of_circle) BATCH(radius_of_circumference) BATCH(area_of_circle) BATCH(perimeter_of_ellipse) BATCH(area_of_ellipse)
+BATCH(eccentricity_of_ellipse) BATCH(latus_rectum_of_ellipse) BATCH(distance)
+// 3D
+BATCH(area_of_cube) BATCH(volume_of_cube) BATCH(area_of_cylinder) BATCH(volume_of_cylinder) BATCH(area_of_cone) BATCH(volume_of_cone)
+BATCH(area_of_sphere) BATCH(volume_of_sphere) BATCH(volume_of_prism)
+// moving objects
+BATCH(kinetic_energy) BATCH(time_of_free_fall) BATCH(braking_distance) BATCH(acceleration_for_distance) BATCH(final_velocity)
+BATCH(acceleration_of)
+// vehicles
+BATCH(turning_radius_of_vehicle)
+// aircrafts
+BATCH(true_airspeed) BATCH(lift_force_of_wing) BATCH(Mach_number) BATCH(glide_path) BATCH(vertical_height) BATCH(climb_rate)
+// gravitation
+BATCH(gravitational_potential_energy) BATCH(gravitational_attractive_force) BATCH(gravitational_escape_velocity)
+BATCH(flattening_factor) BATCH(local_gravity)
+// various
+BATCH(wavelength) BATCH(speed_of_sound_in_air) BATCH(drag_in_fluid) BATCH(frequency_of_chromatic_note) BATCH(Newtons_motion)
+BATCH(Lorentz_force) BATCH(windchill_temperature) BATCH(density_of_dry_air) BATCH(density_of) BATCH(mass_of) BATCH(volume_of)
+BATCH(BMI) BATCH(consumed_electrical_power) BATCH(sound_intensity) BATCH(ballistic_max_height) BATCH(ballistic_max_range)
+BATCH(ballistic_travel_time) BATCH(absorbed_dose)
+
+} } // namespace SI::formula
+
+#undef BATCH
+
+// References
+// ----------
+// 1. https://en.cppreference.com/w/cpp/container/span (std::span)
@@ -0,0 +1,109 @@
+// <SI/checked.h> - checked math: reports floating-point exceptions (NaN, infinities) of batch kernels and batched formulas
+//                 (compiled in by defining SI_CHECKED_MATH, else the checks compile to nothing)
+#pragma once
+#include <cfenv>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <SI/internal.h>
+#ifdef SI_CHECKED_MATH
+#include <SI/conversion.h>
+#endif
+
+namespace SI
+{
+	// a floating-point exception raised by a batch kernel or a batched formula (reported with SI_CHECKED_MATH only)
+	struct fp_error
+	{
+		const char* function; // e.g. "formula::time_of_free_fall"
+		std::string inputs;   // the dimensions of the inputs in SI base units, e.g. "m, m·s⁻²" ("1" for dimensionless)
+		int flags;            // the raised exceptions: FE_INVALID (a NaN), FE_DIVBYZERO or FE_OVERFLOW (an infinity)
+	};
+
+	using fp_error_handler = void (*)(const fp_error&);
+
+	namespace detail
+	{
+		// the exceptions checked for (underflows and inexact results are normal)
+		constexpr int checked_fp_exceptions = FE_INVALID | FE_DIVBYZERO | FE_OVERFLOW;
+
+		inline void print_fp_error(const fp_error& error)
+		{
+			std::fprintf(stderr, "SI: floating-point exception (%s%s%s) in %s(%s)\n", (error.flags & FE_INVALID) ? "invalid operation " : "",
+				(error.flags & FE_DIVBYZERO) ? "division by zero " : "", (error.flags & FE_OVERFLOW) ? "overflow " : "", error.function, error.inputs.c_str());
+		}
+
+		inline fp_error_handler fp_error_handler_of_checked_math = print_fp_error;
+	}
+
+	// Sets the function to be called on floating-point exceptions in checked math (by default they're printed to stderr),
+	// and returns the previous one. The handler is called from the thread calling the batch kernel.
+	inline fp_error_handler set_fp_error_handler(fp_error_handler handler)
+	{
+		return std::exchange(detail::fp_error_handler_of_checked_math, handler);
+	}
+
+#ifdef SI_CHECKED_MATH
+	namespace detail
+	{
+		template <class... Inputs>
+		struct dimension_list
+		{
+			static std::string get()
+			{
+				std::string result;
+				((result += (result.empty() ? "" : ", ") + symbol_of_dimension<dimension_of_t<Inputs>>()), ...);
+				return result;
+			}
+
+			template <class Dimension> static std::string symbol_of_dimension()
+			{
+				const std::string& symbol = base_unit_symbol<Dimension>();
+				return symbol.empty() ? "1" : symbol;
+			}
+		};
+		template <class... Inputs> struct dimension_list<std::tuple<Inputs...>> : dimension_list<Inputs...> {};
+
+		// Tests the floating-point exception flags on construction and destruction, so a batch is checked with two
+		// calls in total (they're cleared only if raised before, and then restored afterwards).
+		class fp_check
+		{
+		public:
+			fp_check(const char* function, std::string (*inputs)()) : m_function(function), m_inputs(inputs)
+			{
+				m_raised_before = std::fetestexcept(checked_fp_exceptions);
+				if (m_raised_before != 0)
+					std::feclearexcept(m_raised_before);
+			}
+
+			~fp_check()
+			{
+				if (const int flags = std::fetestexcept(checked_fp_exceptions))
+					fp_error_handler_of_checked_math({ m_function, m_inputs(), flags });
+				if (m_raised_before != 0)
+					std::feraiseexcept(m_raised_before);
+			}
+
+			fp_check(const fp_check&) = delete;
+			fp_check& operator=(const fp_check&) = delete;
+
+		private:
+			const char* m_function;
+			std::string (*m_inputs)();
+			int m_raised_before;
+		};
+	}
+
+	// Checks the current scope (a batch kernel or batched formula) for floating-point exceptions, e.g.
+	// SI_CHECK_FP("pow", T) or SI_CHECK_FP("kinetic_energy", mass, velocity). The compiler may still evaluate
+	// constant expressions at compile-time without raising anything (only runtime values are checked).
+#define SI_CHECK_FP(_function, ...) const SI::detail::fp_check si_fp_check_(_function, &SI::detail::dimension_list<__VA_ARGS__>::get)
+#else
+#define SI_CHECK_FP(_function, ...)
+#endif
+} // namespace SI
+
+// References
+// ----------
+// 1. https://en.cppreference.com/w/cpp/numeric/fenv (floating-point environment)
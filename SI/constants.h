@@ -5,7 +5,7 @@
 
 namespace SI { namespace constant {
 
-#define CONSTANT(_name, _value, _base_unit) const auto _name = _base_unit(_value)
+#define CONSTANT(_name, _value, _base_unit) constexpr auto _name = _base_unit(_value)
 
 // +++ DEFINED CONSTANTS +++
 CONSTANT(caesium_frequency,     9'192'631'770, hertz); // the unperturbed ground state hyperfine transition frequency of the ceesium-133 atom
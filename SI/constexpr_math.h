@@ -0,0 +1,333 @@
+// <SI/constexpr_math.h> - math functions usable in constant expressions, e.g. constexpr auto x = SI::constexpr_math::sqrt(2.0);
+//                         (at run-time they call the <cmath> functions, at compile-time they evaluate series in long double)
+#pragma once
+#include <cmath>
+#include <limits>
+
+#if (defined(__GNUC__) && __GNUC__ >= 9) || (defined(__clang__) && __clang_major__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define SI_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define SI_IS_CONSTANT_EVALUATED() true // (not detectable, so the series are used at run-time as well)
+#endif
+
+namespace SI { namespace constexpr_math {
+
+	namespace detail
+	{
+		using real = long double;
+
+		constexpr real pi = 3.141592653589793238462643383279502884L;
+		constexpr real ln2 = 0.693147180559945309417232121458176568L;
+		constexpr real ln10 = 2.302585092994045684017991454684364208L;
+		constexpr real sqrt2 = 1.414213562373095048801688724209698079L;
+		constexpr real inf = std::numeric_limits<real>::infinity();
+		constexpr real nan = std::numeric_limits<real>::quiet_NaN();
+
+		constexpr bool is_nan(real x) { return x != x; }
+		constexpr bool is_inf(real x) { return x == inf || x == -inf; }
+
+		// returns x * 2^e
+		constexpr real scale2(real x, long e)
+		{
+			for (; e >= 64; e -= 64) x *= 0x1p64L;
+			for (; e <= -64; e += 64) x *= 0x1p-64L;
+			for (; e > 0; e--) x *= 2;
+			for (; e < 0; e++) x /= 2;
+			return x;
+		}
+
+		// splits x > 0 into m * 2^e with m in [1, 2)
+		constexpr real split2(real x, long& e)
+		{
+			e = 0;
+			for (; x >= 0x1p64L; e += 64) x *= 0x1p-64L;
+			for (; x < 0x1p-64L; e -= 64) x *= 0x1p64L;
+			for (; x >= 2; e++) x /= 2;
+			for (; x < 1; e--) x *= 2;
+			return x;
+		}
+
+		// rounds to the nearest integer (for |x| < 2^63)
+		constexpr real round(real x)
+		{
+			return static_cast<real>(static_cast<long long>(x < 0 ? x - 0.5L : x + 0.5L));
+		}
+
+		constexpr real sqrt(real x)
+		{
+			if (is_nan(x) || x < 0)
+				return nan;
+			if (x == 0 || is_inf(x))
+				return x;
+			long e = 0;
+			real m = split2(x, e);
+			if (e % 2 != 0) // x = m * 4^(e/2) with m in [1, 4)
+			{
+				m *= 2;
+				e--;
+			}
+			real y = 0.5L + 0.5L * m;
+			for (int i = 0; i < 6; i++) // (Newton's method, the error squares in each step)
+				y = 0.5L * (y + m / y);
+			return scale2(y, e / 2);
+		}
+
+		constexpr real exp(real x)
+		{
+			if (is_nan(x))
+				return x;
+			if (x > 11357)
+				return inf;
+			if (x < -11400)
+				return 0;
+			const real k = round(x / ln2); // x = k * ln2 + r with |r| <= ln2 / 2
+			const real r = x - k * ln2;
+			real term = 1, sum = 1;
+			for (int n = 1; n < 28; n++)
+			{
+				term *= r / n;
+				sum += term;
+			}
+			return scale2(sum, static_cast<long>(k));
+		}
+
+		constexpr real log(real x)
+		{
+			if (is_nan(x) || x < 0)
+				return nan;
+			if (x == 0)
+				return -inf;
+			if (is_inf(x))
+				return x;
+			long e = 0; // x = m * 2^e with m in [sqrt(0.5), sqrt(2))
+			x = split2(x, e);
+			if (x > sqrt2)
+			{
+				x /= 2;
+				e++;
+			}
+			const real s = (x - 1) / (x + 1), s2 = s * s; // log(m) = 2 * atanh(s)
+			real term = s, sum = 0;
+			for (int n = 1; n < 48; n += 2)
+			{
+				sum += term / n;
+				term *= s2;
+			}
+			return 2 * sum + e * ln2;
+		}
+
+		constexpr real pow(real x, real y)
+		{
+			if (y == 0)
+				return 1;
+			if (is_nan(x) || is_nan(y))
+				return nan;
+			if (y > -1e9L && y < 1e9L && y == round(y)) // (integer exponents by squaring, also for negative x)
+			{
+				real result = 1, base = y < 0 ? 1 / x : x;
+				for (long long n = static_cast<long long>(y < 0 ? -y : y); n > 0; n /= 2, base *= base)
+				{
+					if (n % 2 == 1)
+						result *= base;
+				}
+				return result;
+			}
+			if (x < 0)
+				return nan;
+			if (x == 0)
+				return y > 0 ? 0 : inf;
+			return exp(y * log(x));
+		}
+
+		constexpr real cbrt(real x)
+		{
+			if (x == 0 || is_nan(x) || is_inf(x))
+				return x;
+			const real a = x < 0 ? -x : x;
+			real y = exp(log(a) / 3);
+			y -= (y * y * y - a) / (3 * y * y); // (one Newton step to polish)
+			return x < 0 ? -y : y;
+		}
+
+		// x = k * π/2 + r with r in [-π/4, π/4], series of sin(r) and cos(r)
+		constexpr real sin_series(real r)
+		{
+			real term = r, sum = 0;
+			for (int n = 1; n < 40; n += 2)
+			{
+				sum += term;
+				term *= -r * r / ((n + 1) * (n + 2));
+			}
+			return sum;
+		}
+
+		constexpr real cos_series(real r)
+		{
+			real term = 1, sum = 0;
+			for (int n = 0; n < 40; n += 2)
+			{
+				sum += term;
+				term *= -r * r / ((n + 1) * (n + 2));
+			}
+			return sum;
+		}
+
+		constexpr real sin(real x)
+		{
+			if (is_nan(x) || is_inf(x))
+				return nan;
+			const real k = round(x / (pi / 2));
+			const real r = x - k * (pi / 2);
+			switch (static_cast<long long>(k) & 3)
+			{
+			case 0: return sin_series(r);
+			case 1: return cos_series(r);
+			case 2: return -sin_series(r);
+			default: return -cos_series(r);
+			}
+		}
+
+		constexpr real cos(real x)
+		{
+			if (is_nan(x) || is_inf(x))
+				return nan;
+			const real k = round(x / (pi / 2));
+			const real r = x - k * (pi / 2);
+			switch (static_cast<long long>(k) & 3)
+			{
+			case 0: return cos_series(r);
+			case 1: return -sin_series(r);
+			case 2: return -cos_series(r);
+			default: return sin_series(r);
+			}
+		}
+
+		constexpr real atan(real x)
+		{
+			if (is_nan(x))
+				return x;
+			if (x < 0)
+				return -atan(-x);
+			if (x > 1)
+				return pi / 2 - atan(1 / x);
+			x = x / (1 + sqrt(1 + x * x)); // (halves the angle twice, so the series converges fast)
+			x = x / (1 + sqrt(1 + x * x));
+			real term = x, sum = 0;
+			for (int n = 1; n < 48; n += 2)
+			{
+				sum += term / n;
+				term *= -x * x;
+			}
+			return 4 * sum;
+		}
+
+		constexpr real atan2(real y, real x)
+		{
+			if (is_nan(x) || is_nan(y))
+				return nan;
+			if (x > 0)
+				return atan(y / x);
+			if (x < 0)
+				return y < 0 ? atan(y / x) - pi : atan(y / x) + pi;
+			return y > 0 ? pi / 2 : y < 0 ? -pi / 2 : 0;
+		}
+	}
+
+	template <class T> constexpr auto sqrt(T x) -> decltype(std::sqrt(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::sqrt(x))>(detail::sqrt(x));
+		return std::sqrt(x);
+	}
+
+	template <class T> constexpr auto cbrt(T x) -> decltype(std::cbrt(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::cbrt(x))>(detail::cbrt(x));
+		return std::cbrt(x);
+	}
+
+	template <class T, class U> constexpr auto pow(T x, U y) -> decltype(std::pow(x, y))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::pow(x, y))>(detail::pow(x, y));
+		return std::pow(x, y);
+	}
+
+	template <class T> constexpr auto exp(T x) -> decltype(std::exp(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::exp(x))>(detail::exp(x));
+		return std::exp(x);
+	}
+
+	template <class T> constexpr auto log(T x) -> decltype(std::log(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::log(x))>(detail::log(x));
+		return std::log(x);
+	}
+
+	template <class T> constexpr auto log10(T x) -> decltype(std::log10(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::log10(x))>(detail::log(x) / detail::ln10);
+		return std::log10(x);
+	}
+
+	template <class T> constexpr auto sin(T x) -> decltype(std::sin(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::sin(x))>(detail::sin(x));
+		return std::sin(x);
+	}
+
+	template <class T> constexpr auto cos(T x) -> decltype(std::cos(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::cos(x))>(detail::cos(x));
+		return std::cos(x);
+	}
+
+	template <class T> constexpr auto tan(T x) -> decltype(std::tan(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::tan(x))>(detail::sin(x) / detail::cos(x));
+		return std::tan(x);
+	}
+
+	template <class T> constexpr auto asin(T x) -> decltype(std::asin(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::asin(x))>(x < -1 || x > 1 ? detail::nan : detail::atan2(x, detail::sqrt((1 - detail::real(x)) * (1 + detail::real(x)))));
+		return std::asin(x);
+	}
+
+	template <class T> constexpr auto acos(T x) -> decltype(std::acos(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::acos(x))>(x < -1 || x > 1 ? detail::nan : detail::atan2(detail::sqrt((1 - detail::real(x)) * (1 + detail::real(x))), x));
+		return std::acos(x);
+	}
+
+	template <class T> constexpr auto atan(T x) -> decltype(std::atan(x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::atan(x))>(detail::atan(x));
+		return std::atan(x);
+	}
+
+	template <class T, class U> constexpr auto atan2(T y, U x) -> decltype(std::atan2(y, x))
+	{
+		if (SI_IS_CONSTANT_EVALUATED())
+			return static_cast<decltype(std::atan2(y, x))>(detail::atan2(y, x));
+		return std::atan2(y, x);
+	}
+
+} } // namespace SI::constexpr_math
+
+// References
+// ----------
+// 1. https://en.cppreference.com/w/cpp/types/is_constant_evaluated
+// 2. https://en.wikipedia.org/wiki/Methods_of_computing_square_roots
+// 3. https://en.wikipedia.org/wiki/Taylor_series
@@ -1,456 +1,233 @@
 // <SI/conversion.h> - convert SI datatypes <-> string, e.g. from_string("12m", my_length); 
 #pragma once
+#include <array>
 #include <string>
-#include <SI/literals.h>
+#include <SI/registry.h>
 
 namespace SI
 {
-	std::string format_of_to_string = "%.2Lf%s"; // <-- configurable (precision / whitespace)
-
-	bool from_string(const std::string& str, length& result)
+	// how to_string() formats values, e.g. to_string(12_km, { 3, true }) for "12.000 km"
+	struct string_format
 	{
-		double value;
-		char unit[1024];
-		if (std::sscanf(str.c_str(), "%lf%s", &value, unit) != 2)
-			return false; // not recognized
+		int precision = 2;       // <-- digits after the decimal point
+		bool spaced = false;     // <-- a space between value and unit, e.g. "12.00 km" (not before "°")
+		bool base_units = false; // <-- SI base units only, e.g. "12000.00m" instead of "12.00km", or "0.79rad" instead of "45.00°"
+	};
 
-		if (unit == "Gm")
-			result = 1_Gm * value;
-		else if (unit == "Mm")
-			result = 1_Mm * value;
-		else if (unit == "km")
-			result = 1_km * value;
-		else if (unit == "m")
-			result = 1_m * value;
-		else if (unit == "dm")
-			result = 1_dm * value;
-		else if (unit == "cm")
-			result = 1_cm * value;
-		else if (unit == "mm")
-			result = 1_mm * value;
-		else if (unit == "um")
-			result = 1_um * value;
-		else if (unit == "nm")
-			result = 1_nm * value;
-		else if (unit == "pm")
-			result = 1_pm * value;
-		else
-			return false; // unknown unit
-
-		return true;
-	}
-
-	bool from_string(const std::string& str, time& result)
+	// Returns the format of to_string() for the calling thread, configurable e.g. by format_of_to_string().precision = 3
+	// (per thread, so all threads may format concurrently without locks, new threads start with the defaults).
+	inline string_format& format_of_to_string()
 	{
-		double value;
-		char unit[1024];
-		if (std::sscanf(str.c_str(), "%lf%s", &value, unit) != 2)
-			return false; // not recognized
-
-		if (unit == "day" || unit == "days")
-			result = 1_day * value;
-		else if (unit == "h" || unit == "hrs")
-			result = 1_h * value;
-		else if (unit == "m" || unit == "min")
-			result = 1_min * value;
-		else if (unit == "s" || unit == "sec" || unit == "seconds")
-			result = 1_s * value;
-		else if (unit == "ms")
-			result = 1_ms * value;
-		else if (unit == "us")
-			result = 1_us * value;
-		else if (unit == "ns")
-			result = 1_ns * value;
-		else if (unit == "ps")
-			result = 1_ps * value;
-		else
-			return false; // unknown unit
-
-		return true;
+		thread_local string_format format;
+		return format;
 	}
 
-	bool from_string(const std::string& str, mass& result)
+	// convert a string such as "12km" or "12 km/h" into the SI datatype (fails on unknown units or wrong dimensions)
+	template <class Dimension>
+	bool from_string(const std::string& str, detail::quantity<Dimension, SIdouble>& result)
 	{
-		double value;
+		SI_PROFILE_SCOPE("from_string");
+		double number;
 		char unit[1024];
-		if (std::sscanf(str.c_str(), "%lf%s", &value, unit) != 2)
+		if (std::sscanf(str.c_str(), "%lf%1023s", &number, unit) != 2)
 			return false; // not recognized
 
-		if (unit == "Gt")
-			result = 1_Gt * value;
-		else if (unit == "Mt")
-			result = 1_Mt * value;
-		else if (unit == "kt")
-			result = 1_kt * value;
-		else if (unit == "t")
-			result = 1_t * value;
-		else if (unit == "kg")
-			result = 1_kg * value;
-		else if (unit == "g")
-			result = 1_g * value;
-		else if (unit == "mg")
-			result = 1_mg * value;
-		else if (unit == "ug")
-			result = 1_ug * value;
-		else if (unit == "ng")
-			result = 1_ng * value;
-		else
-			return false; // unknown unit
-
-		return true;
+		return from_unit(number, unit, result);
 	}
 
 	// internal function to join and convert both value and unit into a string.
-	std::string _join(long double value, const std::string& unit)
+	std::string _join(long double value, const std::string& unit, const string_format& format = format_of_to_string())
 	{
 		char buf[256];
-		std::snprintf(buf, sizeof(buf), format_of_to_string.c_str(), value, unit.c_str());
+		const bool spaced = format.spaced && !unit.empty() && unit != "°";
+		std::snprintf(buf, sizeof(buf), "%.*Lf%s%s", format.precision, value, spaced ? " " : "", unit.c_str());
 		return std::string(buf);
 	}
 
-	// convert the 7 SI base units:
-	std::string to_string(length d)
-	{
-		if (d <= -1_Gpc || d >= 1_Gpc)
-			return _join(d / 1_Gpc, "Gpc (gigaparsec)");
-		if (d <= -1_Mpc || d >= 1_Mpc)
-			return _join(d / 1_Mpc, "Mpc (megaparsec)");
-		if (d <= -1_kpc || d >= 1_kpc)
-			return _join(d / 1_kpc, "kpc (kiloparsec)");
-		if (d <= -1_pc || d >= 1_pc)
-			return _join(d / 1_pc, "pc"); // parsec
-		if (d <= -1_ly || d >= 1_ly)
-			return _join(d / 1_ly, "ly"); // light-years
-		if (d <= -1_au || d >= 1_au)
-			return _join(d / 1_au, "au"); // astronomical unit
-		if (d <= -1_km || d >= 1_km)
-			return _join(d / 1_km, "km");
-		if (d <= -1_m || d >= 1_m || d == 0.0_m)
-			return _join(d / 1_m, "m");
-		if (d <= -1_cm || d >= 1_cm)
-			return _join(d / 1_cm, "cm");
-		if (d <= -1_mm || d >= 1_mm)
-			return _join(d / 1_mm, "mm");
-		if (d <= -1_um || d >= 1_um)
-			return _join(d / 1_um, "μm");
-		if (d <= -1_nm || d >= 1_nm)
-			return _join(d / 1_nm, "nm");
-
-		return _join(d / 1_pm, "pm");
-	}
-
-	std::string to_string(time t)
-	{
-		if (abs(t) >= 365.25_days)
-			return _join(t / 365.25_days, " year(s)");
-		if (abs(t) >= 7_days)
-			return _join(t / 7_days, " week(s)");
-		if (abs(t) > 1_day)
-			return _join(t / 1_day, "days");
-		if (t <= -1_h || t >= 1_h)
-			return _join(t / 1_h, "h");
-		if (t <= -1_min || t >= 1_min)
-			return _join(t / 1_min, "min");
-		if (t <= -1_s || t >= 1_s || t == 0.0_s)
-			return _join(t / 1_s, "s");
-		if (t <= -1_ms || t >= 1_ms)
-			return _join(t / 1_ms, "ms");
-		if (t <= -1_us || t >= 1_us)
-			return _join(t / 1_us, "μs");
-		if (t <= -1_ns || t >= 1_ns)
-			return _join(t / 1_ns, "ns");
-
-		return _join(t / 1_ps, "ps");
-	}
-
-	std::string to_string(mass m)
-	{
-		if (m <= -1_Gt || m >= 1_Gt)
-			return _join(m / 1_Gt, "Gt");
-		if (m <= -1_Mt || m >= 1_Mt)
-			return _join(m / 1_Mt, "Mt");
-		if (m <= -1_kt || m >= 1_kt)
-			return _join(m / 1_kt, "kt");
-		if (m <= -1_t || m >= 1_t)
-			return _join(m / 1_t, "t");
-		if (m <= -1_kg || m >= 1_kg || m == 0.0_kg)
-			return _join(m / 1_kg, "kg");
-		if (m <= -1_g || m >= 1_g)
-			return _join(m / 1_g, "g");
-		if (m <= -1_mg || m >= 1_mg)
-			return _join(m / 1_mg, "mg");
-		if (m <= -1_ug || m >= 1_ug)
-			return _join(m / 1_ug, "µg");
-
-		return _join(m / 1_ng, "ng");
-	}
-
-	std::string to_string(temperature T)
-	{
-		if (T <= -1_GK || T >= 1_GK)
-			return _join(T / 1_GK, "GK");
-		if (T <= -1_MK || T >= 1_MK)
-			return _join(T / 1_MK, "MK");
-		if (T >= 250_K && T <= 470_K) // human temperature range
-			return _join(celsius(T), "°C (") + _join(fahrenheit(T), "°F") + ")";
-		if (T <= -1_K || T >= 1_K || T == 0.0_K)
-			return _join(T / 1_K, "K");
-		if (T <= -1_mK || T >= 1_mK)
-			return _join(T / 1_mK, "mK");
-		if (T <= -1_uK || T >= 1_uK)
-			return _join(T / 1_uK, "μK");
-
-		return _join(T / 1_nK, "nK");
-	}
-
-	std::string to_string(electric_current I)
-	{
-		if (I <= -1_GA || I >= 1_GA)
-			return _join(I / 1_GA, "GA");
-		if (I <= -1_MA || I >= 1_MA)
-			return _join(I / 1_MA, "MA");
-		if (I <= -1_kA || I >= 1_kA)
-			return _join(I / 1_kA, "kA");
-		if (I <= -1_A || I >= 1_A || I == 0.0_A)
-			return _join(I / 1_A, "A");
-		if (I <= -1_mA || I >= 1_mA)
-			return _join(I / 1_mA, "mA");
-		if (I <= -1_uA || I >= 1_uA)
-			return _join(I / 1_uA, "μA");
-		if (I <= -1_nA || I >= 1_nA)
-			return _join(I / 1_nA, "nA");
-
-		return _join(I / 1_pA, "pA");
-	}
-
-	// Convert the 22 derived SI units:
-	std::string to_string(area a)
-	{
-		if (a <= -1_km² || a >= 1_km²)
-			return _join(a / 1_km², "km²");
-		if (a <= -1_hm² || a >= 1_hm²)
-			return _join(a / 1_hm², "hm²");
-		if (a <= -1_m² || a >= 1_m² || a == 0.0_m²)
-			return _join(a / 1_m², "m²");
-		if (a <= -1_cm² || a >= 1_cm²)
-			return _join(a / 1_cm², "cm²");
-		if (a <= -1_mm² || a >= 1_mm²)
-			return _join(a / 1_mm², "mm²");
-
-		return _join(a / 1_um², "μm²");
-	}
-
-	std::string to_string(per_area a)
-	{
-		if (a <= -1_per_km² || a >= 1_per_km²)
-			return _join(a / 1_per_km², "/km²");
-		if (a <= -1_per_hm² || a >= 1_per_hm²)
-			return _join(a / 1_per_hm², "/hm²");
-		if (a <= -1_per_m² || a >= 1_per_m² || a == 0.0_per_m²)
-			return _join(a / 1_per_m², "/m²");
-		if (a <= -1_per_cm² || a >= 1_per_cm²)
-			return _join(a / 1_per_cm², "/cm²");
-		if (a <= -1_per_mm² || a >= 1_per_mm²)
-			return _join(a / 1_per_mm², "/mm²");
-
-		return _join(a / 1_per_μm², "/μm²");
-	}
-
-	std::string to_string(volume v)
-	{
-		if (v <= -1_km³ || v >= 1_km³)
-			return _join(v / 1_km³, "km³");
-		if (v <= -1_m³ || v >= 1_m³)
-			return _join(v / 1_m³, "m³");
-		if (v <= -1_l || v >= 1_l || v == 0.0_l)
-			return _join(v / 1_l, "l");
-		if (v <= -1_ml || v >= 1_ml)
-			return _join(v / 1_ml, "ml");
-		if (v <= -1_ul || v >= 1_ul)
-			return _join(v / 1_ul, "μl");
-		if (v <= -1_nl || v >= 1_nl)
-			return _join(v / 1_nl, "nl");
-
-		return _join(v / 1_pl, "pl");
-	}
-
-	std::string to_string(velocity v)
-	{
-		if (v <= -1_km_per_h || v >= 1_km_per_h)
-			return _join(v / 1_km_per_h, "km/h");
-		if (v <= -1_m_per_s || v >= 1_m_per_s || v == 0.0_m_per_s)
-			return _join(v / 1_m_per_s, "m/s");
-
-		return _join(v / 1_mm_per_h, "mm/h");
-	}
-
-	std::string to_string(acceleration a)
-	{
-		if (a <= -1_km_per_s² || a >= 1_km_per_s²)
-			return _join(a / 1_km_per_s², "km/s");
-
-		return _join(a / 1_m_per_s², "m/s²");
-	}
-
-	std::string to_string(frequency f)
-	{
-		if (f <= -1_THz || f >= 1_THz)
-			return _join(f / 1_THz, "THz");
-		if (f <= -1_GHz || f >= 1_GHz)
-			return _join(f / 1_GHz, "GHz");
-		if (f <= -1_MHz || f >= 1_MHz)
-			return _join(f / 1_MHz, "MHz");
-		if (f <= -1_kHz || f >= 1_kHz)
-			return _join(f / 1_kHz, "kHz");
-		if (f <= -1_Hz || f >= 1_Hz || f == 0.0_Hz)
-			return _join(f / 1_Hz, "Hz");
-
-		return _join(f / 1_mHz, "mHz");
-	}
-
-	std::string to_string(force F)
-	{
-		if (F <= -1_ZN || F >= 1_ZN)
-			return _join(F / 1_ZN, "ZN");
-		if (F <= -1_EN || F >= 1_EN)
-			return _join(F / 1_EN, "EN");
-		if (F <= -1_PN || F >= 1_PN)
-			return _join(F / 1_PN, "PN");
-		if (F <= -1_TN || F >= 1_TN)
-			return _join(F / 1_TN, "TN");
-		if (F <= -1_GN || F >= 1_GN)
-			return _join(F / 1_GN, "GN");
-		if (F <= -1_MN || F >= 1_MN)
-			return _join(F / 1_MN, "MN");
-		if (F <= -1_kN || F >= 1_kN)
-			return _join(F / 1_kN, "kN");
-		if (F <= -1_N || F >= 1_N || F == 0.0_N)
-			return _join(F / 1_N, "N");
-		if (F <= -1_mN || F >= 1_mN)
-			return _join(F / 1_mN, "mN");
-		if (F <= -1_uN || F >= 1_uN)
-			return _join(F / 1_uN, "µN");
-
-		return _join(F / 1_pN, "pN");
-	}
-
-	std::string to_string(energy E)
-	{
-		if (E <= -1_PJ || E >= 1_PJ)
-			return _join(E / 1_PJ, "PJ");
-		if (E <= -1_TJ || E >= 1_TJ)
-			return _join(E / 1_TJ, "TJ");
-		if (E <= -1_GJ || E >= 1_GJ)
-			return _join(E / 1_GJ, "GJ");
-		if (E <= -1_MJ || E >= 1_MJ)
-			return _join(E / 1_MJ, "MJ");
-		if (E <= -1_kJ || E >= 1_kJ)
-			return _join(E / 1_kJ, "kJ");
-		if (E <= -1_J || E >= 1_J || E == 0.0_J)
-			return _join(E / 1_J, "J");
-
-		return _join(E / 1_mJ, "mJ");
-	}
-
-	std::string to_string(power P)
-	{
-		if (P <= -1_TWh || P >= 1_TWh)
-			return _join(P / 1_TWh, "TWh");
-		if (P <= -1_GWh || P >= 1_GWh)
-			return _join(P / 1_GWh, "GWh");
-		if (P <= -1_MWh || P >= 1_MWh)
-			return _join(P / 1_MWh, "MWh");
-		if (P <= -1_kWh || P >= 1_kWh)
-			return _join(P / 1_kWh, "kWh");
-
-		return _join(P / 1_Wh, "Wh");
-	}
-
-	std::string to_string(power_intensity I)
-	{
-		if (I <= -1_MW_per_m² || I >= 1_MW_per_m²)
-			return _join(I / 1_MW_per_m², "MW/m²");
-		if (I <= -1_kW_per_m² || I >= 1_kW_per_m²)
-			return _join(I / 1_kW_per_m², "kW/m²");
-		if (I <= -1_W_per_m² || I >= 1_W_per_m²)
-			return _join(I / 1_W_per_m², "W/m²");
-
-		return _join(I / 1_mW_per_m², "mW/m²");
-	}
-
-	std::string to_string(pressure p)
-	{
-		if (p <= -1_MPa || p >= 1_MPa)
-			return _join(p / 1_MPa, "MPa");
-		if (p <= -1_kPa || p >= 1_kPa)
-			return _join(p / 1_kPa, "kPa");
-		if (p <= -1_hPa || p >= 1_hPa)
-			return _join(p / 1_hPa, "hPa");
-		if (p <= -1_Pa || p >= 1_Pa || p == 0.0_Pa)
-			return _join(p / 1_Pa, "Pa");
-		if (p <= -1_mPa || p >= 1_mPa)
-			return _join(p / 1_mPa, "mPa");
-
-		return _join(p / 1_uPa, "µPa");
-	}
-
-	std::string to_string(electric_potential U)
-	{
-		if (U <= -1_GV || U >= 1_GV)
-			return _join(U / 1_GV, "GV");
-		if (U <= -1_MV || U >= 1_MV)
-			return _join(U / 1_MV, "MV");
-		if (U <= -1_kV || U >= 1_kV)
-			return _join(U / 1_kV, "kV");
-		if (U <= -1_V || U >= 1_V || U == 0.0_V)
-			return _join(U / 1_V, "V");
-		if (U <= -1_mV || U >= 1_mV)
-			return _join(U / 1_mV, "mV");
-		if (U <= -1_uV || U >= 1_uV)
-			return _join(U / 1_uV, "μV");
-		if (U <= -1_nV || U >= 1_nV)
-			return _join(U / 1_nV, "nV");
-		return _join(U / 1_pV, "pV");
+	namespace detail
+	{
+		// a unit to display values in, e.g. { 1e3, "km" }
+		struct display_unit
+		{
+			SIdouble factor; // (in SI base units)
+			const char* symbol;
+			bool above_only = false; // (for values above the factor only, e.g. 1 day is shown as 24.00h)
+		};
+
+		// the display units per dimension, sorted from big to small unit (dimensions without are shown in SI base units)
+		template <class Dimension>
+		struct display_units
+		{
+			static constexpr bool defined = false;
+		};
+
+#define DISPLAY_UNITS(_datatype, _zero_symbol, ...)                               \
+		template <> struct display_units<_datatype ## _dimension>                 \
+		{                                                                         \
+			static constexpr bool defined = true;                                 \
+			static constexpr const char* zero_symbol = _zero_symbol;              \
+			static constexpr display_unit table[] = { __VA_ARGS__ };              \
+			static constexpr size_t count = sizeof(table) / sizeof(table[0]);     \
+		};
+#define U(_literal, _symbol) display_unit{ value(_literal), _symbol }
+#define U_ABOVE(_literal, _symbol) display_unit{ value(_literal), _symbol, true }
+
+		// +++ SI BASE UNITS +++
+		DISPLAY_UNITS(length, "m", U(1_Gpc, "Gpc (gigaparsec)"), U(1_Mpc, "Mpc (megaparsec)"), U(1_kpc, "kpc (kiloparsec)"),
+			U(1_pc, "pc"), U(1_ly, "ly"), U(1_au, "au"), U(1_km, "km"), U(1_m, "m"), U(1_cm, "cm"), U(1_mm, "mm"),
+			U(1_um, "μm"), U(1_nm, "nm"), U(1_pm, "pm"))
+		DISPLAY_UNITS(time, "s", U(365.25_days, " year(s)"), U(7_days, " week(s)"), U_ABOVE(1_day, "days"), U(1_h, "h"),
+			U(1_min, "min"), U(1_s, "s"), U(1_ms, "ms"), U(1_us, "μs"), U(1_ns, "ns"), U(1_ps, "ps"))
+		DISPLAY_UNITS(mass, "kg", U(1_Gt, "Gt"), U(1_Mt, "Mt"), U(1_kt, "kt"), U(1_t, "t"), U(1_kg, "kg"), U(1_g, "g"),
+			U(1_mg, "mg"), U(1_ug, "µg"), U(1_ng, "ng"))
+		DISPLAY_UNITS(temperature, "K", U(1_GK, "GK"), U(1_MK, "MK"), U(1_K, "K"), U(1_mK, "mK"), U(1_uK, "μK"), U(1_nK, "nK"))
+		DISPLAY_UNITS(electric_current, "A", U(1_GA, "GA"), U(1_MA, "MA"), U(1_kA, "kA"), U(1_A, "A"), U(1_mA, "mA"),
+			U(1_uA, "μA"), U(1_nA, "nA"), U(1_pA, "pA"))
+
+		// +++ SI DERIVED UNITS +++
+		DISPLAY_UNITS(area, "m²", U(1_km², "km²"), U(1_hm², "hm²"), U(1_m², "m²"), U(1_cm², "cm²"), U(1_mm², "mm²"), U(1_um², "μm²"))
+		DISPLAY_UNITS(per_area, "/m²", U(1_per_km², "/km²"), U(1_per_hm², "/hm²"), U(1_per_m², "/m²"), U(1_per_cm², "/cm²"),
+			U(1_per_mm², "/mm²"), U(1_per_μm², "/μm²"))
+		DISPLAY_UNITS(volume, "l", U(1_km³, "km³"), U(1_m³, "m³"), U(1_l, "l"), U(1_ml, "ml"), U(1_ul, "μl"), U(1_nl, "nl"), U(1_pl, "pl"))
+		DISPLAY_UNITS(velocity, "m/s", U(1_km_per_h, "km/h"), U(1_m_per_s, "m/s"), U(1_mm_per_h, "mm/h"))
+		DISPLAY_UNITS(acceleration, "m/s²", U(1_km_per_s², "km/s²"), U(1_m_per_s², "m/s²"))
+		DISPLAY_UNITS(angular_speed, "rad/s", U(1_rad_per_s, "rad/s"))
+		DISPLAY_UNITS(frequency, "Hz", U(1_THz, "THz"), U(1_GHz, "GHz"), U(1_MHz, "MHz"), U(1_kHz, "kHz"), U(1_Hz, "Hz"), U(1_mHz, "mHz"))
+		DISPLAY_UNITS(force, "N", U(1_ZN, "ZN"), U(1_EN, "EN"), U(1_PN, "PN"), U(1_TN, "TN"), U(1_GN, "GN"), U(1_MN, "MN"),
+			U(1_kN, "kN"), U(1_N, "N"), U(1_mN, "mN"), U(1_uN, "µN"), U(1_pN, "pN"))
+		DISPLAY_UNITS(energy, "J", U(1_PJ, "PJ"), U(1_TJ, "TJ"), U(1_GJ, "GJ"), U(1_MJ, "MJ"), U(1_kJ, "kJ"), U(1_J, "J"), U(1_mJ, "mJ"))
+		DISPLAY_UNITS(power, "Wh", U(1_TWh, "TWh"), U(1_GWh, "GWh"), U(1_MWh, "MWh"), U(1_kWh, "kWh"), U(1_Wh, "Wh"))
+		DISPLAY_UNITS(power_intensity, "mW/m²", U(1_MW_per_m², "MW/m²"), U(1_kW_per_m², "kW/m²"), U(1_W_per_m², "W/m²"),
+			U(1_mW_per_m², "mW/m²"))
+		DISPLAY_UNITS(pressure, "Pa", U(1_MPa, "MPa"), U(1_kPa, "kPa"), U(1_hPa, "hPa"), U(1_Pa, "Pa"), U(1_mPa, "mPa"), U(1_uPa, "µPa"))
+		DISPLAY_UNITS(electric_potential, "V", U(1_GV, "GV"), U(1_MV, "MV"), U(1_kV, "kV"), U(1_V, "V"), U(1_mV, "mV"),
+			U(1_uV, "μV"), U(1_nV, "nV"), U(1_pV, "pV"))
+		DISPLAY_UNITS(electric_charge, "Ah", U(1_GAh, "GAh"), U(1_MAh, "MAh"), U(1_kAh, "kAh"), U(1_Ah, "Ah"), U(1_mAh, "mAh"), U(1_uAh, "µAh"))
+		DISPLAY_UNITS(mass_per_area, "kg/m²", U(1_kg_per_m², "kg/m²"))
+		DISPLAY_UNITS(density, "kg/m³", U(1_kg_per_m³, "kg/m³"))
+
+#undef U
+#undef U_ABOVE
+#undef DISPLAY_UNITS
+
+		// Maps the binary exponent of a value to the first display unit which might fit, so the selection
+		// takes one table lookup plus (at most) a few comparisons no matter how many units a dimension has.
+		template <class Dimension>
+		struct display_unit_index
+		{
+			using units = display_units<Dimension>;
+			static constexpr int min_exponent = -128; // (values beyond are clamped, i.e. shown in the smallest/biggest unit)
+			static constexpr int max_exponent = 127;
+
+			static constexpr auto build()
+			{
+				std::array<unsigned char, max_exponent - min_exponent + 1> index{};
+				for (int e = min_exponent; e <= max_exponent; e++)
+				{
+					SIdouble upper = 2; // = 2^(e+1), the values with exponent e are below
+					for (int i = 0; i < e; i++)
+						upper *= 2;
+					for (int i = 0; i > e; i--)
+						upper /= 2;
+
+					size_t first = 0;
+					while (first + 1 < units::count && units::table[first].factor >= upper)
+						first++;
+					index[e - min_exponent] = static_cast<unsigned char>(first);
+				}
+				return index;
+			}
+			static constexpr auto index = build();
+
+			static const display_unit& select(SIdouble x)
+			{
+				const SIdouble magnitude = std::fabs(x);
+				const int exponent = std::clamp(std::ilogb(magnitude), min_exponent, max_exponent);
+				size_t i = index[exponent - min_exponent];
+				while (i + 1 < units::count && (magnitude < units::table[i].factor || (magnitude == units::table[i].factor && units::table[i].above_only)))
+					i++;
+				return units::table[i];
+			}
+		};
+
+		// Returns the symbol of the SI base units of the dimension, e.g. "m·s⁻³" for jerk
+		template <class Dimension>
+		const std::string& base_unit_symbol()
+		{
+			static const std::string symbol = []
+			{
+				const char* superscripts[] = { "⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷", "⁸", "⁹" };
+				const std::pair<const char*, long> exponents[] = { { "m", Dimension::length }, { "kg", Dimension::mass },
+					{ "s", Dimension::time }, { "K", Dimension::temperature }, { "A", Dimension::current },
+					{ "mol", Dimension::substance }, { "cd", Dimension::intensity } };
+				std::string result;
+				for (auto& [unit, exponent] : exponents)
+				{
+					if (exponent == 0)
+						continue;
+					result += result.empty() ? unit : std::string("·") + unit;
+					if (exponent < 0)
+						result += "⁻";
+					if (exponent != 1)
+						for (char digit : std::to_string(std::abs(exponent)))
+							result += superscripts[digit - '0'];
+				}
+				return result;
+			}();
+			return symbol;
+		}
+	}
+
+	// convert all SI datatypes into the best fitting display unit of the dimension:
+	template <class Dimension, class T, class = std::enable_if_t<std::is_arithmetic_v<T>>>
+	std::string to_string(const detail::quantity<Dimension, T>& x, const string_format& format = format_of_to_string())
+	{
+		SI_PROFILE_SCOPE("to_string(quantity)");
+		using units = detail::display_units<Dimension>;
+		const SIdouble v = value(x);
+
+		if constexpr (units::defined)
+		{
+			if (format.base_units)
+				return _join(v, detail::base_unit_symbol<Dimension>(), format);
+
+			if (v == 0)
+				return _join(v, units::zero_symbol, format);
+
+			const auto& unit = detail::display_unit_index<Dimension>::select(v);
+			return _join(v / unit.factor, unit.symbol, format);
+		}
+		else
+			return _join(v, detail::base_unit_symbol<Dimension>(), format);
 	}
 
-	std::string to_string(electric_charge Q)
+	std::string to_string(temperature T, const string_format& format = format_of_to_string())
 	{
-		if (Q <= -1_GAh || Q >= 1_GAh)
-			return _join(Q / 1_MAh, "MAh");
-		if (Q <= -1_MAh || Q >= 1_MAh)
-			return _join(Q / 1_MAh, "MAh");
-		if (Q <= -1_kAh || Q >= 1_kAh)
-			return _join(Q / 1_kAh, "kAh");
-		if (Q <= -1_Ah || Q >= 1_Ah || Q == 0.0_Ah)
-			return _join(Q / 1_Ah, "Ah");
-		if (Q <= -1_mAh || Q >= 1_mAh)
-			return _join(Q / 1_mAh, "mAh");
+		SI_PROFILE_SCOPE("to_string(temperature)");
+		if (T >= 250_K && T <= 470_K && !format.base_units) // human temperature range
+			return _join(celsius(T), "°C (", format) + _join(fahrenheit(T), "°F", format) + ")";
 
-		return _join(Q / 1_uAh, "µAh");
+		return to_string<detail::temperature_dimension, SIdouble>(T, format);
 	}
 
-	std::string to_string(mass_per_area v)
+	std::string to_string(angle a, const string_format& format = format_of_to_string())
 	{
-		return _join(v / 1_kg_per_m², "kg/m²");
-	}
+		SI_PROFILE_SCOPE("to_string(angle)");
+		if (format.base_units)
+			return _join(a, "rad", format);
 
-	std::string to_string(density d)
-	{
-		return _join(d / 1_kg_per_m³, "kg/m³");
-	}
-
-	std::string to_string(angle a)
-	{
-		return _join(a / 1_deg, "°");
+		return _join(a / 1_deg, "°", format);
 	}
 
-	std::string to_string(dimensionless value)
+	std::string to_string(dimensionless value, const string_format& format = format_of_to_string())
 	{
-		return _join(value, "");
+		SI_PROFILE_SCOPE("to_string(dimensionless)");
+		return _join(value, "", format);
 	}
 
 	std::string to_string(char glyph)
 	{
+		SI_PROFILE_SCOPE("to_string(char)");
 		char buf[256];
 		std::snprintf(buf, sizeof(buf), "%c", glyph);
 		return std::string(buf);
@@ -458,6 +235,7 @@ namespace SI
 
 	std::string to_string(const std::string& text)
 	{
+		SI_PROFILE_SCOPE("to_string(string)");
 		return text;
 	}
 } // namespace SI
@@ -4,10 +4,13 @@
 
 namespace SI
 {
+// (xxx_t<T> doesn't deduce T from arguments, so functions taking xxx_t<T> convert other value types such as int implicitly)
+// (define SI_PACKED_DIMENSIONS for all translation units to encode the dimensions as one integer instead of 7, the
+//  datatypes stay the same but their symbol names get shorter, see detail::packed_dimension in <SI/internal.h>)
 #define DATATYPE(_name, _lengthExp, _massExp, _timeExp, _TemperatureExp, _currentExp, _substanceExp, _intensityExp) \
     namespace detail { using _name ## _dimension = dimension<_lengthExp, _massExp, _timeExp, _TemperatureExp,       \
 	                                                     _currentExp, _substanceExp, _intensityExp>; }          \
-    template <class T> using _name ## _t = detail::quantity<detail:: _name ## _dimension, T>;                       \
+    template <class T> using _name ## _t = detail::identity_t<detail::quantity<detail:: _name ## _dimension, T>>;   \
     using _name = _name ## _t<SIdouble>;                                                                            \
     using _name ## 2 = _name ## _t<detail::vec2<SIdouble>>;                                                         \
     using _name ## 3 = _name ## _t<detail::vec3<SIdouble>>
@@ -43,11 +46,21 @@ namespace SI
 	DATATYPE(electric_charge,        0, 0,  1, 0, 1, 0, 0); // in amperes per second
 	DATATYPE(mass_per_area,         -2, 1,  0, 0, 0, 0, 0); // in kilograms per square meter
 	DATATYPE(per_amount_of_substance,0, 0,  0, 0,-1, 0, 0); // per mol (reciprocal)
-	DATATYPE(angular_speed,          0, 0, -1, 0, 1, 0, 0); // in degrees per second
 	DATATYPE(specific_energy,        2, 0, -2, 0, 0, 0, 0); // in joules per kilogram
 	DATATYPE(energy_per_mol,         2, 1, -2, 0, 0, 1, 0); // in joules per mol
 	DATATYPE(volume_per_time_squared,3, 0, -2, 0, 0, 0, 0); // in cubic meter per square second
 
+	// +++ TAGGED DATATYPES +++ (the dimension of another datatype, but a type of its own that doesn't convert implicitly)
+	namespace detail
+	{
+		struct angular_speed_dimension : frequency_dimension {}; // (s⁻¹ as frequency, but in radians and not cycles per second)
+		template <> struct dimension_of<angular_speed_dimension> { using type = angular_speed_dimension; };
+	}
+	template <class T> using angular_speed_t = detail::identity_t<detail::quantity<detail::angular_speed_dimension, T>>;
+	using angular_speed = angular_speed_t<SIdouble>;   // in radians per second
+	using angular_speed2 = angular_speed_t<detail::vec2<SIdouble>>;
+	using angular_speed3 = angular_speed_t<detail::vec3<SIdouble>>;
+
 #undef DATATYPE
 } // namespace SI
 
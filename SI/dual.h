@@ -0,0 +1,213 @@
+// <SI/dual.h> - forward-mode automatic differentiation, e.g. derivative(formula::braking_distance<dual<SIdouble>>(v, 0_m_per_s, a), v)
+//               (dual numbers usable as value type of all SI datatypes like vec2/vec3, derivatives keep their dimensions)
+#pragma once
+#include <SI/conversion.h>
+
+namespace SI
+{
+	namespace internal
+	{
+		// A dual number: the real value and its partial derivatives by N variables (seeds), calculated in one pass.
+		template <class T, int N = 1>
+		struct dual
+		{
+			static_assert(std::is_floating_point_v<T> && N > 0);
+
+			T real = 0;
+			T derivatives[N] = {};
+
+			constexpr dual() = default;
+
+			constexpr dual(T x) : real(x) {} // NOLINT(google-explicit-constructor)
+
+			// Returns the variable x, seeded as variable number (index), i.e. with the derivative 1 at index.
+			static constexpr dual variable(T x, int index)
+			{
+				dual result(x);
+				result.derivatives[index] = 1;
+				return result;
+			}
+		};
+
+		namespace detail
+		{
+			// returns f(x) by the chain rule, with f'(x.real) given as derivative
+			template <class T, int N> constexpr dual<T, N> chain(const dual<T, N>& x, T f, T derivative)
+			{
+				dual<T, N> result(f);
+				for (int i = 0; i < N; i++)
+					result.derivatives[i] = derivative * x.derivatives[i];
+				return result;
+			}
+		}
+
+		// unary operators
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> operator-(const dual<T, N>& x) { return detail::chain(x, -x.real, T(-1)); }
+
+		// comparsion operators (of the real values)
+		template <class T, int N> [[nodiscard]] constexpr bool operator==(const dual<T, N>& lhs, const dual<T, N>& rhs) { return lhs.real == rhs.real; }
+		template <class T, int N> [[nodiscard]] constexpr bool operator!=(const dual<T, N>& lhs, const dual<T, N>& rhs) { return lhs.real != rhs.real; }
+		template <class T, int N> [[nodiscard]] constexpr bool operator<(const dual<T, N>& lhs, const dual<T, N>& rhs) { return lhs.real < rhs.real; }
+		template <class T, int N> [[nodiscard]] constexpr bool operator<=(const dual<T, N>& lhs, const dual<T, N>& rhs) { return lhs.real <= rhs.real; }
+		template <class T, int N> [[nodiscard]] constexpr bool operator>(const dual<T, N>& lhs, const dual<T, N>& rhs) { return lhs.real > rhs.real; }
+		template <class T, int N> [[nodiscard]] constexpr bool operator>=(const dual<T, N>& lhs, const dual<T, N>& rhs) { return lhs.real >= rhs.real; }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator==(const dual<T, N>& lhs, U rhs) { return lhs.real == rhs; }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator!=(const dual<T, N>& lhs, U rhs) { return lhs.real != rhs; }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator<(const dual<T, N>& lhs, U rhs) { return lhs.real < rhs; }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator<=(const dual<T, N>& lhs, U rhs) { return lhs.real <= rhs; }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator>(const dual<T, N>& lhs, U rhs) { return lhs.real > rhs; }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator>=(const dual<T, N>& lhs, U rhs) { return lhs.real >= rhs; }
+
+		// binary operators with other dual numbers (the loops over the derivatives are vectorized by the compiler)
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> operator+(const dual<T, N>& lhs, const dual<T, N>& rhs)
+		{
+			dual<T, N> result(lhs.real + rhs.real);
+			for (int i = 0; i < N; i++)
+				result.derivatives[i] = lhs.derivatives[i] + rhs.derivatives[i];
+			return result;
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> operator-(const dual<T, N>& lhs, const dual<T, N>& rhs)
+		{
+			dual<T, N> result(lhs.real - rhs.real);
+			for (int i = 0; i < N; i++)
+				result.derivatives[i] = lhs.derivatives[i] - rhs.derivatives[i];
+			return result;
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> operator*(const dual<T, N>& lhs, const dual<T, N>& rhs)
+		{
+			dual<T, N> result(lhs.real * rhs.real);
+			for (int i = 0; i < N; i++)
+				result.derivatives[i] = lhs.derivatives[i] * rhs.real + lhs.real * rhs.derivatives[i];
+			return result;
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> operator/(const dual<T, N>& lhs, const dual<T, N>& rhs)
+		{
+			const T inverse = 1 / rhs.real;
+			dual<T, N> result(lhs.real * inverse);
+			for (int i = 0; i < N; i++)
+				result.derivatives[i] = (lhs.derivatives[i] - result.real * rhs.derivatives[i]) * inverse;
+			return result;
+		}
+
+		// binary operators with scalars
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator+(const dual<T, N>& lhs, U rhs) { return detail::chain(lhs, lhs.real + rhs, T(1)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator-(const dual<T, N>& lhs, U rhs) { return detail::chain(lhs, lhs.real - rhs, T(1)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator*(const dual<T, N>& lhs, U rhs) { return detail::chain(lhs, lhs.real * rhs, T(rhs)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator/(const dual<T, N>& lhs, U rhs) { return detail::chain(lhs, lhs.real / rhs, 1 / T(rhs)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator+(U lhs, const dual<T, N>& rhs) { return detail::chain(rhs, lhs + rhs.real, T(1)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator-(U lhs, const dual<T, N>& rhs) { return detail::chain(rhs, lhs - rhs.real, T(-1)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator*(U lhs, const dual<T, N>& rhs) { return detail::chain(rhs, lhs * rhs.real, T(lhs)); }
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> operator/(U lhs, const dual<T, N>& rhs) { return detail::chain(rhs, lhs / rhs.real, -lhs / (rhs.real * rhs.real)); }
+
+		// compound assignment
+		template <class T, int N, class U> constexpr dual<T, N>& operator+=(dual<T, N>& lhs, const U& rhs) { return lhs = lhs + rhs; }
+		template <class T, int N, class U> constexpr dual<T, N>& operator-=(dual<T, N>& lhs, const U& rhs) { return lhs = lhs - rhs; }
+		template <class T, int N, class U> constexpr dual<T, N>& operator*=(dual<T, N>& lhs, const U& rhs) { return lhs = lhs * rhs; }
+		template <class T, int N, class U> constexpr dual<T, N>& operator/=(dual<T, N>& lhs, const U& rhs) { return lhs = lhs / rhs; }
+
+		// math functions by the chain rule
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> abs(const dual<T, N>& x) { return x.real < 0 ? -x : x; }
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> sqrt(const dual<T, N>& x)
+		{
+			const T f = constexpr_math::sqrt(x.real);
+			return detail::chain(x, f, 1 / (2 * f));
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> cbrt(const dual<T, N>& x)
+		{
+			const T f = constexpr_math::cbrt(x.real);
+			return detail::chain(x, f, 1 / (3 * f * f));
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> exp(const dual<T, N>& x)
+		{
+			const T f = constexpr_math::exp(x.real);
+			return detail::chain(x, f, f);
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> log(const dual<T, N>& x) { return detail::chain(x, constexpr_math::log(x.real), 1 / x.real); }
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> log10(const dual<T, N>& x) { return detail::chain(x, constexpr_math::log10(x.real), 1 / (x.real * T(2.302585092994045684))); }
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> sin(const dual<T, N>& x) { return detail::chain(x, constexpr_math::sin(x.real), constexpr_math::cos(x.real)); }
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> cos(const dual<T, N>& x) { return detail::chain(x, constexpr_math::cos(x.real), -constexpr_math::sin(x.real)); }
+
+		template <class T, int N, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr dual<T, N> pow(const dual<T, N>& x, U y)
+		{
+			return detail::chain(x, T(constexpr_math::pow(x.real, y)), T(y * constexpr_math::pow(x.real, y - 1)));
+		}
+
+		template <class T, int N> [[nodiscard]] constexpr dual<T, N> pow(const dual<T, N>& x, const dual<T, N>& y)
+		{
+			return exp(y * log(x)); // (for x > 0)
+		}
+
+		// convert dual numbers into strings (the real value only)
+		template <class T, int N>
+		std::string to_string(const dual<T, N>& x, const string_format& format = format_of_to_string())
+		{
+			return SI::to_string(static_cast<SIdouble>(x.real), format);
+		}
+
+		template <class Dimension, class T, int N>
+		std::string to_string(const SI::detail::quantity<Dimension, dual<T, N>>& x, const string_format& format = format_of_to_string())
+		{
+			return SI::to_string(SI::detail::quantity<Dimension, T>(Dimension(), value(x).real), format);
+		}
+	}
+
+	namespace detail
+	{
+		template <class T, int N>
+		using dual = internal::dual<T, N>;
+
+		template <class T, int N> struct is_arithmetic<internal::dual<T, N>> : std::true_type {}; // (for units, e.g. meters(dual<SIdouble>(1.0)))
+		template <class T, int N> struct scalar_value_type<internal::dual<T, N>> { using type = T; };
+
+		template <class T, int N>
+		constexpr void fill(internal::dual<T, N>& x, T value)
+		{
+			x = value;
+		}
+	}
+
+	using internal::dual;
+
+	// Returns the quantity (x) as variable number (index) of N variables, e.g. variable<2>(72_km_per_h, 0).
+	template <int N, class Dimension, class T>
+	constexpr auto variable(const detail::quantity<Dimension, T>& x, int index)
+	{
+		return detail::quantity<Dimension, dual<T, N>>(Dimension(), dual<T, N>::variable(value(x), index));
+	}
+
+	// Returns the real value of a dual quantity, e.g. real(formula::braking_distance<dual<SIdouble, 2>>(...)).
+	template <class Dimension, class T, int N>
+	constexpr auto real(const detail::quantity<Dimension, dual<T, N>>& x)
+	{
+		return detail::quantity<Dimension, T>(Dimension(), value(x).real);
+	}
+
+	// Returns the partial derivative of (y) by variable (x), with the dimension of y / x (e.g. length by velocity is time).
+	template <class DimensionY, class DimensionX, class T, int N>
+	constexpr auto derivative(const detail::quantity<DimensionY, dual<T, N>>& y, const detail::quantity<DimensionX, dual<T, N>>& x)
+	{
+		T numerator = 0, denominator = 0; // (the directional derivative along the seed of x, i.e. dy/dx for x seeded as variable)
+		for (int i = 0; i < N; i++)
+		{
+			numerator += value(y).derivatives[i] * value(x).derivatives[i];
+			denominator += value(x).derivatives[i] * value(x).derivatives[i];
+		}
+		using result_dimension = detail::dimension_subtract<DimensionY, DimensionX>;
+		if constexpr (detail::is_dimensionless_v<result_dimension>)
+			return numerator / denominator;
+		else
+			return detail::quantity<result_dimension, T>(result_dimension(), numerator / denominator);
+	}
+} // namespace SI
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Automatic_differentiation#Forward_accumulation
+// 2. https://en.wikipedia.org/wiki/Dual_number
@@ -0,0 +1,344 @@
+// <SI/export.h> - streaming CSV and JSON writers for SI datatypes and dataset rows, e.g. csv_writer(stdout).rows(planets, ...);
+//                 (values are written in the chosen display units, the unit symbols once per column in the header)
+#pragma once
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <SI/literals.h>
+
+namespace SI
+{
+	struct no_unit {}; // <- marks columns holding plain values such as text, numbers, or flags
+
+	template <class Unit>
+	struct column_t;
+
+	// a single value bound to its column (returned by column_t::operator() and field_t::operator())
+	template <class Unit, class T>
+	struct cell_t
+	{
+		const column_t<Unit>& column;
+		const T& value;
+	};
+
+	// an output column: name, display unit (a unit such as kilometers or a quantity such as 1_au), and unit symbol
+	template <class Unit>
+	struct column_t
+	{
+		const char* name;
+		Unit unit;
+		const char* symbol;
+
+		template <class T>
+		cell_t<Unit, T> operator()(const T& value) const { return { *this, value }; }
+	};
+
+	// an output column bound to a data member of a struct, e.g. of dataset::planet_data
+	template <class Struct, class Member, class Unit>
+	struct field_t
+	{
+		Member Struct::* member;
+		column_t<Unit> column;
+
+		cell_t<Unit, Member> operator()(const Struct& row) const { return column(row.*member); }
+	};
+
+	// a column for plain values (text, numbers, flags)
+	column_t<no_unit> column(const char* name)
+	{
+		return { name, {}, nullptr };
+	}
+
+	// a column for SI datatypes, written in the given display unit
+	template <class Unit>
+	column_t<Unit> column(const char* name, Unit unit, const char* symbol)
+	{
+		return { name, unit, symbol };
+	}
+
+	// a field for plain data members (text, numbers, flags)
+	template <class Struct, class Member>
+	field_t<Struct, Member, no_unit> field(Member Struct::* member, const char* name)
+	{
+		return { member, column(name) };
+	}
+
+	// a field for SI data members, written in the given display unit
+	template <class Struct, class Member, class Unit>
+	field_t<Struct, Member, Unit> field(Member Struct::* member, const char* name, Unit unit, const char* symbol)
+	{
+		return { member, column(name, unit, symbol) };
+	}
+
+	namespace detail
+	{
+		template <class Unit> const column_t<Unit>& column_of(const column_t<Unit>& c) { return c; }
+		template <class Struct, class Member, class Unit> const column_t<Unit>& column_of(const field_t<Struct, Member, Unit>& f) { return f.column; }
+
+		// converts the value into the display unit of the column
+		template <class Unit, class T>
+		auto display_value(const Unit& unit, const T& x)
+		{
+			if constexpr (std::is_same_v<Unit, no_unit>)
+			{
+				static_assert(!is_si_v<T>, "SI datatypes need a display unit, e.g. column(\"height\", meters, \"m\")");
+				return x;
+			}
+			else if constexpr (is_si_v<Unit>)
+				return x / unit; // e.g. 1_au
+			else
+				return unit(x);  // e.g. kilometers
+		}
+
+		// writes a plain value, the overloads are shared by the CSV and JSON writer
+		void write_value(std::FILE* file, double x, int precision, bool json)
+		{
+			if (json && !std::isfinite(x))
+				std::fputs("null", file);
+			else
+				std::fprintf(file, "%.*g", precision, x);
+		}
+
+		void write_value(std::FILE* file, bool x, int, bool)
+		{
+			std::fputs(x ? "true" : "false", file);
+		}
+
+		void write_value(std::FILE* file, long long x, int, bool)
+		{
+			std::fprintf(file, "%lld", x);
+		}
+
+		template <class T>
+		std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>> write_value(std::FILE* file, T x, int precision, bool json)
+		{
+			if constexpr (std::is_floating_point_v<T>)
+				write_value(file, static_cast<double>(x), precision, json);
+			else
+				write_value(file, static_cast<long long>(x), precision, json);
+		}
+
+		template <class T>
+		void write_value(std::FILE* file, const vec2<T>& v, int precision, bool json)
+		{
+			std::fputs(json ? "[" : "", file);
+			write_value(file, v.x, precision, json); std::fputs(json ? "," : " ", file);
+			write_value(file, v.y, precision, json);
+			std::fputs(json ? "]" : "", file);
+		}
+
+		template <class T>
+		void write_value(std::FILE* file, const vec3<T>& v, int precision, bool json)
+		{
+			std::fputs(json ? "[" : "", file);
+			write_value(file, v.x, precision, json); std::fputs(json ? "," : " ", file);
+			write_value(file, v.y, precision, json); std::fputs(json ? "," : " ", file);
+			write_value(file, v.z, precision, json);
+			std::fputs(json ? "]" : "", file);
+		}
+
+		// writes text, quoted for CSV (when needed) or escaped for JSON
+		void write_text(std::FILE* file, const char* text, char separator, bool json)
+		{
+			if (text == nullptr)
+				text = "";
+			if (json)
+			{
+				std::fputc('"', file);
+				for (const char* c = text; *c; c++)
+				{
+					if (*c == '"' || *c == '\\')
+						std::fputc('\\', file), std::fputc(*c, file);
+					else if (static_cast<unsigned char>(*c) < 0x20)
+						std::fprintf(file, "\\u%04x", static_cast<unsigned>(*c));
+					else
+						std::fputc(*c, file);
+				}
+				std::fputc('"', file);
+				return;
+			}
+			bool needs_quotes = false;
+			for (const char* c = text; *c && !needs_quotes; c++)
+				needs_quotes = (*c == separator || *c == '"' || *c == '\n' || *c == '\r');
+			if (!needs_quotes)
+			{
+				std::fputs(text, file);
+				return;
+			}
+			std::fputc('"', file);
+			for (const char* c = text; *c; c++)
+			{
+				if (*c == '"')
+					std::fputc('"', file);
+				std::fputc(*c, file);
+			}
+			std::fputc('"', file);
+		}
+
+		void write_value(std::FILE* file, const char* text, int, bool json)
+		{
+			write_text(file, text, ',', json);
+		}
+	}
+
+	// Writes CSV with one header line "name (unit),..." followed by one line per row.
+	class csv_writer
+	{
+	public:
+		explicit csv_writer(std::FILE* file = stdout, int precision = 15, char separator = ',')
+			: m_file(file), m_precision(precision), m_separator(separator)
+		{}
+
+		// writes the header line, accepts columns and fields
+		template <class... Columns>
+		csv_writer& header(const Columns&... columns)
+		{
+			int index = 0;
+			(write_name(index++, detail::column_of(columns)), ...);
+			std::fputc('\n', m_file);
+			return *this;
+		}
+
+		// writes a single row of cells, e.g. row(time_column(t), position_column(p))
+		template <class... Cells>
+		csv_writer& row(const Cells&... cells)
+		{
+			int index = 0;
+			(write_cell(index++, cells), ...);
+			std::fputc('\n', m_file);
+			return *this;
+		}
+
+		// writes the header plus all rows of a table (e.g. dataset::planets) by the given fields
+		template <class Rows, class... Fields>
+		csv_writer& rows(const Rows& table, const Fields&... fields)
+		{
+			header(fields...);
+			for (const auto& r : table)
+				row(fields(r)...);
+			return *this;
+		}
+
+	private:
+		std::FILE* m_file;
+		int m_precision;
+		char m_separator;
+
+		template <class Unit>
+		void write_name(int index, const column_t<Unit>& c)
+		{
+			if (index > 0)
+				std::fputc(m_separator, m_file);
+			detail::write_text(m_file, c.name, m_separator, false);
+			if (c.symbol != nullptr)
+				std::fprintf(m_file, " (%s)", c.symbol);
+		}
+
+		template <class Unit, class T>
+		void write_cell(int index, const cell_t<Unit, T>& cell)
+		{
+			if (index > 0)
+				std::fputc(m_separator, m_file);
+			const auto& x = detail::display_value(cell.column.unit, cell.value);
+			if constexpr (std::is_convertible_v<decltype(x), const char*>)
+				detail::write_text(m_file, x, m_separator, false);
+			else
+				detail::write_value(m_file, x, m_precision, false);
+		}
+	};
+
+	// Writes JSON as {"columns":[{"name":..,"unit":..},..],"rows":[[..],..]} - the units are listed once per column.
+	class json_writer
+	{
+	public:
+		explicit json_writer(std::FILE* file = stdout, int precision = 15)
+			: m_file(file), m_precision(precision)
+		{}
+
+		~json_writer()
+		{
+			close();
+		}
+
+		// writes the column list and opens the row array, accepts columns and fields
+		template <class... Columns>
+		json_writer& header(const Columns&... columns)
+		{
+			close();
+			std::fputs("{\"columns\":[", m_file);
+			int index = 0;
+			(write_name(index++, detail::column_of(columns)), ...);
+			std::fputs("],\n\"rows\":[", m_file);
+			m_open = true;
+			m_rows = 0;
+			return *this;
+		}
+
+		// writes a single row of cells, e.g. row(time_column(t), position_column(p))
+		template <class... Cells>
+		json_writer& row(const Cells&... cells)
+		{
+			std::fputs(m_rows++ > 0 ? ",\n[" : "\n[", m_file);
+			int index = 0;
+			(write_cell(index++, cells), ...);
+			std::fputc(']', m_file);
+			return *this;
+		}
+
+		// writes the header plus all rows of a table (e.g. dataset::planets) by the given fields
+		template <class Rows, class... Fields>
+		json_writer& rows(const Rows& table, const Fields&... fields)
+		{
+			header(fields...);
+			for (const auto& r : table)
+				row(fields(r)...);
+			return close();
+		}
+
+		// closes the row array and the JSON object (done by the destructor otherwise)
+		json_writer& close()
+		{
+			if (m_open)
+				std::fputs("]}\n", m_file);
+			m_open = false;
+			return *this;
+		}
+
+	private:
+		std::FILE* m_file;
+		int m_precision;
+		bool m_open = false;
+		long m_rows = 0;
+
+		template <class Unit>
+		void write_name(int index, const column_t<Unit>& c)
+		{
+			std::fputs(index > 0 ? ",{\"name\":" : "{\"name\":", m_file);
+			detail::write_text(m_file, c.name, ',', true);
+			if (c.symbol != nullptr)
+			{
+				std::fputs(",\"unit\":", m_file);
+				detail::write_text(m_file, c.symbol, ',', true);
+			}
+			std::fputc('}', m_file);
+		}
+
+		template <class Unit, class T>
+		void write_cell(int index, const cell_t<Unit, T>& cell)
+		{
+			if (index > 0)
+				std::fputc(',', m_file);
+			const auto& x = detail::display_value(cell.column.unit, cell.value);
+			if constexpr (std::is_convertible_v<decltype(x), const char*>)
+				detail::write_text(m_file, x, ',', true);
+			else
+				detail::write_value(m_file, x, m_precision, true);
+		}
+	};
+} // namespace SI
+
+// References
+// ----------
+// 1. https://www.rfc-editor.org/rfc/rfc4180 (Common Format and MIME Type for CSV Files)
+// 2. https://www.rfc-editor.org/rfc/rfc8259 (The JavaScript Object Notation (JSON) Data Interchange Format)
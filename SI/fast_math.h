@@ -0,0 +1,232 @@
+// <SI/fast_math.h> - opt-in fast approximations of sqrt, pow, root, trigonometry and log10, e.g. SI::fast::sqrt(2_m²)
+//                    (polynomials without libm calls and errno, sqrt aside, for real-time loops tolerating ~1e-7 error)
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <SI/batch.h>
+
+// The functions in namespace SI::fast are a drop-in policy: replace sqrt(x) by fast::sqrt(x) at the call site and
+// the dimension checks stay the same. The error bounds below hold for finite, normal (not subnormal) arguments and
+// were measured by the accuracy table of benchmarks.cpp against libm:
+//
+//   function             max. error                 range
+//   fast::sqrt()         correctly rounded          x >= 0
+//   fast::root<N>()      1e-9 relative (N <= 6)     x >= 0 (any x for odd N)
+//   fast::pow<N>()       |N| ulp relative           any x
+//   fast::sin/cos()      3e-8 absolute              |x| <= 1e5 rad
+//   fast::tan()          4e-8 relative              |x| <= 1e5 rad
+//   fast::atan2()        8e-8 relative              any y, x
+//   fast::log10()        5e-10 absolute             x > 0
+//
+namespace SI { namespace fast {
+
+	namespace detail
+	{
+		using SI::detail::quantity;
+		using SI::detail::dimension_multiply;
+		using SI::detail::dimension_divide;
+		using SI::detail::value_dimension;
+
+		inline uint64_t bits_of(SIdouble x)
+		{
+			uint64_t bits = 0;
+			std::memcpy(&bits, &x, sizeof(bits));
+			return bits;
+		}
+
+		inline SIdouble from_bits(uint64_t bits)
+		{
+			SIdouble x = 0;
+			std::memcpy(&x, &bits, sizeof(x));
+			return x;
+		}
+
+		// Returns the Degree-th root of x >= 0 by Newton's iteration of z = x^(-1/Degree), which needs no division. The
+		// start value divides the exponent bits (the "fast inverse square root" trick generalized), so 4 iterations
+		// reach 4e-13 for N = 3 and 1e-9 for N = 6.
+		template <long Degree>
+		inline SIdouble root(SIdouble x)
+		{
+			static_assert(Degree > 0, "the degree of a root must be positive");
+			if constexpr (Degree == 1)
+				return x;
+			else if constexpr (Degree == 2)
+				return std::sqrt(x); // (a single instruction, no approximation is faster)
+			else
+			{
+				constexpr auto min = std::numeric_limits<SIdouble>::min();
+				constexpr int64_t one = 0x3FF0000000000000; // (the bits of 1.0)
+				const SIdouble m = std::isgreater(x, min) ? x : min; // (0 yields x * z^(Degree-1) = 0 below)
+				SIdouble z = from_bits(static_cast<uint64_t>(one + (one - static_cast<int64_t>(bits_of(m))) / Degree));
+				for (int i = 0; i < 4; i++)
+					z = z * ((Degree + 1) - m * SI::detail::integer_pow<Degree>(z)) * (1. / Degree);
+				return x * SI::detail::integer_pow<Degree - 1>(z);
+			}
+		}
+
+		// Returns the quadrant and the remainder r in [-pi/4, pi/4] of x = quadrant * pi/2 + r (Cody-Waite reduction
+		// with pi/2 split into 33 + 53 bits, exact for |x| <= 1e5).
+		constexpr SIdouble reduce(SIdouble x, int32_t& quadrant)
+		{
+			constexpr SIdouble round = 0x1.8p52; // (adding and subtracting it rounds to an integer)
+			constexpr SIdouble limit = 1e9; // (k beyond int32_t, NaN or inf would be UB to convert, their results are garbage anyway)
+			const SIdouble k = (x * 6.36619772367581382433e-01 + round) - round;
+			quadrant = static_cast<int32_t>(k >= -limit && k <= limit ? k : 0); // (as in SI::detail::sincos(), but constexpr)
+			return (x - k * 1.57079632673412561417e+00) - k * 6.07710050650619224932e-11;
+		}
+
+		// returns sin(x) from sin(r), cos(r) and the quadrant (q) of x = q * pi/2 + r by arithmetic, for cos(x) pass q + 1
+		// (unlike SI::detail::sin_of_quadrant() for vectorized loops, this leaves no branches in scalar code)
+		constexpr SIdouble sin_of_quadrant(SIdouble sin_r, SIdouble cos_r, int32_t q)
+		{
+			const SIdouble odd = static_cast<SIdouble>(q & 1), sign = static_cast<SIdouble>(1 - (q & 2));
+			return sign * SI::detail::blend(odd, cos_r, sin_r);
+		}
+
+		// sin(r) and cos(r) for |r| <= pi/4 by Taylor polynomials of degree 9 and 8 (absolute error below 2e-9 and 3e-8)
+		constexpr SIdouble sin_poly(SIdouble r)
+		{
+			const SIdouble u = r * r;
+			return r + r * u * (-1. / 6 + u * (1. / 120 + u * (-1. / 5040 + u * (1. / 362880))));
+		}
+
+		constexpr SIdouble cos_poly(SIdouble r)
+		{
+			const SIdouble u = r * r;
+			return 1 - 0.5 * u + u * u * (1. / 24 + u * (-1. / 720 + u * (1. / 40320)));
+		}
+
+		// atan(t) for |t| <= tan(pi/8) by a minimax polynomial (relative error below 8e-8)
+		constexpr SIdouble atan_poly(SIdouble t)
+		{
+			const SIdouble u = t * t;
+			return t + t * u * (-0.33333289728103505 + u * (0.19991556499031685 + u * (-0.14029042258422378 + u * 0.08539422947488905)));
+		}
+
+		// ln(m) for m in [sqrt(1/2), sqrt(2)] by a minimax polynomial in s = (m - 1) / (m + 1) (error below 3e-9 * |ln(m)|)
+		constexpr SIdouble log_poly(SIdouble m)
+		{
+			const SIdouble s = (m - 1) / (m + 1), u = s * s;
+			return 2 * s + 2 * s * u * (0.33333342466191807 + u * (0.19994382068407962 + u * 0.14790408904367824));
+		}
+	}
+
+	// Returns the square root, e.g. fast::sqrt(2_m²) (x >= 0, the sqrt instruction, but loops vectorize only with
+	// -fno-math-errno, else the compiler keeps a scalar sqrt per value and calls libm to set errno for x < 0).
+	template <class Dimension, class T>
+	inline auto sqrt(const detail::quantity<Dimension, T>& x)
+	{
+		using result_dimension = detail::dimension_divide<Dimension, detail::value_dimension<2>>;
+		static_assert(std::is_same_v<detail::dimension_multiply<result_dimension, detail::value_dimension<2>>, Dimension>, "cannot take sqrt of this SI dimension");
+		return detail::quantity<result_dimension, T>(result_dimension(), detail::root<2>(value(x)));
+	}
+
+	inline SIdouble sqrt(SIdouble x)
+	{
+		return detail::root<2>(x);
+	}
+
+	// Returns the Degree-th root, e.g. fast::root<3>(27_m³) (x >= 0 for an even degree).
+	template <long Degree, class Dimension, class T>
+	inline auto root(const detail::quantity<Dimension, T>& x)
+	{
+		using result_dimension = detail::dimension_divide<Dimension, detail::value_dimension<Degree>>;
+		static_assert(std::is_same_v<detail::dimension_multiply<result_dimension, detail::value_dimension<Degree>>, Dimension>, "cannot take root of this SI dimension");
+		const SIdouble r = detail::root<Degree>(std::fabs(value(x)));
+		return detail::quantity<result_dimension, T>(result_dimension(), Degree % 2 == 1 ? std::copysign(r, value(x)) : r);
+	}
+
+	template <long Degree>
+	inline SIdouble root(SIdouble x)
+	{
+		const SIdouble r = detail::root<Degree>(std::fabs(x));
+		return Degree % 2 == 1 ? std::copysign(r, x) : r;
+	}
+
+	// Returns the Exponent-th power by multiplications only, e.g. fast::pow<3>(2_m) (the same as SI::pow<3>(), here
+	// for completeness of the policy).
+	template <long Exponent, class Dimension, class T>
+	constexpr auto pow(const detail::quantity<Dimension, T>& x)
+	{
+		return SI::detail::pow<Exponent>(x);
+	}
+
+	template <long Exponent>
+	constexpr SIdouble pow(SIdouble x)
+	{
+		return SI::detail::integer_pow<Exponent>(x);
+	}
+
+	constexpr SIdouble sin(angle a)
+	{
+		int32_t quadrant = 0;
+		const SIdouble r = detail::reduce(a, quadrant);
+		return detail::sin_of_quadrant(detail::sin_poly(r), detail::cos_poly(r), quadrant);
+	}
+
+	constexpr SIdouble cos(angle a)
+	{
+		int32_t quadrant = 0;
+		const SIdouble r = detail::reduce(a, quadrant);
+		return detail::sin_of_quadrant(detail::sin_poly(r), detail::cos_poly(r), quadrant + 1);
+	}
+
+	constexpr SIdouble tan(angle a)
+	{
+		int32_t quadrant = 0;
+		const SIdouble r = detail::reduce(a, quadrant);
+		const SIdouble s = detail::sin_poly(r), c = detail::cos_poly(r);
+		const SIdouble odd = static_cast<SIdouble>(quadrant & 1);
+		return SI::detail::blend(odd, -c, s) / SI::detail::blend(odd, s, c);
+	}
+
+	constexpr SIdouble sin2(angle x) // returns sin²x
+	{
+		const SIdouble s = fast::sin(x);
+		return s * s;
+	}
+
+	constexpr SIdouble cos2(angle x) // returns cos²x
+	{
+		const SIdouble c = fast::cos(x);
+		return c * c;
+	}
+
+	// Returns the angle of the point (x, y) in [-pi, pi], e.g. fast::atan2(3_m, 4_m) (without branches, which random
+	// directions would mispredict).
+	inline angle atan2(length y, length x)
+	{
+		using SI::detail::step;
+		using SI::detail::blend;
+		constexpr SIdouble pi = 3.14159265358979323846, tan_pi_8 = 0.41421356237309504880, min = std::numeric_limits<SIdouble>::min();
+		const SIdouble ay = std::fabs(value(y)), ax = std::fabs(value(x));
+		const SIdouble high = std::isgreater(ay, ax) ? ay : ax, low = std::isgreater(ay, ax) ? ax : ay;
+		const SIdouble t = low / (std::isgreater(high, min) ? high : min); // (in [0, 1], 0 for y = x = 0)
+		const SIdouble above = step(t - tan_pi_8); // (then atan(t) = pi/4 + atan((t - 1) / (t + 1)))
+		SIdouble a = above * (pi / 4) + detail::atan_poly(blend(above, (t - 1) / (t + 1), t));
+		a = blend(step(ay - ax), pi / 2 - a, a);
+		a = blend(step(value(x)), a, pi - a);
+		return std::copysign(a, value(y));
+	}
+
+	// Returns the base-10 logarithm (x > 0), e.g. fast::log10(1e6) == 6.
+	inline SIdouble log10(SIdouble x)
+	{
+		constexpr SIdouble ln2 = 0.693147180559945309417, log10_e = 0.434294481903251827651;
+		constexpr uint64_t exponent_mask = 0x7FF0000000000000, one = 0x3FF0000000000000;
+		const uint64_t bits = detail::bits_of(x);
+		const SIdouble m = detail::from_bits((bits & ~exponent_mask) | one); // (in [1, 2))
+		const SIdouble above = SI::detail::step(m - 1.41421356237309504880); // (then m / 2 in [sqrt(1/2), 1))
+		const SIdouble exponent = static_cast<SIdouble>(static_cast<int64_t>(bits >> 52) - 1023) + above;
+		return (exponent * ln2 + detail::log_poly(m * (1 - 0.5 * above))) * log10_e;
+	}
+
+} } // namespace SI::fast
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Fast_inverse_square_root
+// 2. https://www.netlib.org/fdlibm/k_sin.c (the Cody-Waite reduction)
+// 3. https://en.wikipedia.org/wiki/Remez_algorithm (the minimax polynomials of atan and ln)
@@ -1,402 +1,469 @@
 // <SI/formulas.h> - 61 common formulas based on type-safe SI datatypes, e.g. SI::formula::wavelength()
 //                   (sorted by: 2D, 3D, moving objects, vehicles, aircrafts, gravitation, various)
+//                   (templates on the value type of the datatypes, e.g. formula::braking_distance<interval<SIdouble>>(...) for bounds)
 #pragma once
 #include <SI/constants.h>
+#include <SI/instrumentation.h>
 
 namespace SI { namespace formula {
 
 // +++ 2D +++
 
 // Calculates the hypotenuse in a right triangle, based on Pythagorean equation: a² + b² = c² 
-length hypotenuse_of_triangle(length a, length b)
+template <class Value = SIdouble>
+constexpr length_t<Value> hypotenuse_of_triangle(length_t<Value> a, length_t<Value> b)
 {
-	return sqrt(a*a + b*b);
+	return SI_PROFILED("formula::hypotenuse_of_triangle", sqrt(a*a + b*b));
 }
 
 // Calculates the angle in a right triangle from opposite (o) and hypotenuse (h).
-angle angle1_in_triangle(length o, length h)
+template <class Value = SIdouble>
+constexpr angle angle1_in_triangle(length_t<Value> o, length_t<Value> h)
 {
-	return radians(asin(o / h));
+	return SI_PROFILED("formula::angle1_in_triangle", radians(constexpr_math::asin(o / h)));
 }
 
 // Calculates the angle in a right triangle from adjacent (a) and hypotenuse (h).
-angle angle2_in_triangle(length a, length h)
+template <class Value = SIdouble>
+constexpr angle angle2_in_triangle(length_t<Value> a, length_t<Value> h)
 {
-	return radians(acos(a / h));
+	return SI_PROFILED("formula::angle2_in_triangle", radians(constexpr_math::acos(a / h)));
 }
 
 // Calculates the angle in a right triangle from adjacent (a) and opposite (o).
-angle angle3_in_triangle(length a, length o)
+template <class Value = SIdouble>
+constexpr angle angle3_in_triangle(length_t<Value> a, length_t<Value> o)
 {
-	return radians(atan(o / a));
+	return SI_PROFILED("formula::angle3_in_triangle", radians(constexpr_math::atan(o / a)));
 }
 
 // Calculates the area of a triangle from base (b) and height (h).
-area area_of_triangle(length b, length h)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_triangle(length_t<Value> b, length_t<Value> h)
 {
-	return 0.5 * b * h;
+	return SI_PROFILED("formula::area_of_triangle", 0.5 * b * h);
 }
 
 // Calculates the perimeter of a rectangle from length (l) and base (b).
-length perimeter_of_rectangle(length l, length b)
+template <class Value = SIdouble>
+constexpr length_t<Value> perimeter_of_rectangle(length_t<Value> l, length_t<Value> b)
 {
-	return 2. * (l + b);
+	return SI_PROFILED("formula::perimeter_of_rectangle", 2. * (l + b));
 }
 
 // Calculates the area of a rectangle from length (l) and base (b).
-area area_of_rectangle(length l, length b)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_rectangle(length_t<Value> l, length_t<Value> b)
 {
-	return l * b;
+	return SI_PROFILED("formula::area_of_rectangle", l * b);
 }
 
 // Calculates the perimeter of a square from length (a).
-length perimeter_of_square(length a)
+template <class Value = SIdouble>
+constexpr length_t<Value> perimeter_of_square(length_t<Value> a)
 {
-	return 4. * a;
+	return SI_PROFILED("formula::perimeter_of_square", 4. * a);
 }
 
 // Calculates the area of a square from length (a).
-area area_of_square(length a)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_square(length_t<Value> a)
 {
-	return a * a;
+	return SI_PROFILED("formula::area_of_square", a * a);
 }
 
 // Calculates the area of a trapezoid from base 1 (b1), base 2 (b2) and height (h).
-area area_of_trapezoid(length b1, length b2, length h)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_trapezoid(length_t<Value> b1, length_t<Value> b2, length_t<Value> h)
 {
-	return 0.5 * (b1 + b2) * h;
+	return SI_PROFILED("formula::area_of_trapezoid", 0.5 * (b1 + b2) * h);
 }
 
 // Calculates the circumference of a circle from radius (r).
-length circumference_of_circle(length r)
+template <class Value = SIdouble>
+constexpr length_t<Value> circumference_of_circle(length_t<Value> r)
 {
-	return constant::tau * r;
+	return SI_PROFILED("formula::circumference_of_circle", constant::tau * r);
 }
 
 // Calculates the radius of a circle from circumference (c).
-length radius_of_circumference(length c)
+template <class Value = SIdouble>
+constexpr length_t<Value> radius_of_circumference(length_t<Value> c)
 {
-	return c / constant::tau;
+	return SI_PROFILED("formula::radius_of_circumference", c / constant::tau);
 }
 
 // Calculates the area of a circle from radius (r).
-area area_of_circle(length r)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_circle(length_t<Value> r)
 {
-	return constant::pi * r * r;
+	return SI_PROFILED("formula::area_of_circle", constant::pi * r * r);
 }
 
 // Calculates approximately(!) the perimeter of an ellipse from length of semi-major axis (a) and length of semi-minor axis (b).
-length perimeter_of_ellipse(length a, length b)
+template <class Value = SIdouble>
+constexpr length_t<Value> perimeter_of_ellipse(length_t<Value> a, length_t<Value> b)
 {
-	return constant::pi * sqrt(2.0 * (square(a) + square(b)));
+	return SI_PROFILED("formula::perimeter_of_ellipse", constant::pi * sqrt(2.0 * (square(a) + square(b))));
 }
 
 // Calculates the area of an ellipse from radius (a) and (b).
-area area_of_ellipse(length a, length b)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_ellipse(length_t<Value> a, length_t<Value> b)
 {
-	return constant::pi * a * b;
+	return SI_PROFILED("formula::area_of_ellipse", constant::pi * a * b);
 }
 
 // Calculates the eccentricity of an ellipse from radius (a) and (b).
-dimensionless eccentricity_of_ellipse(length a, length b)
+template <class Value = SIdouble>
+constexpr Value eccentricity_of_ellipse(length_t<Value> a, length_t<Value> b)
 {
-	return std::sqrt(1.0 - (square(b) / square(a)));
+	using constexpr_math::sqrt;
+	return SI_PROFILED("formula::eccentricity_of_ellipse", sqrt(1.0 - (square(b) / square(a))));
 }
 
 // Calculates the latus rectum of an ellipse from radius (a) and (b).
-length latus_rectum_of_ellipse(length a, length b)
+template <class Value = SIdouble>
+constexpr length_t<Value> latus_rectum_of_ellipse(length_t<Value> a, length_t<Value> b)
 {
-	return 2.0 * square(b) / a;
+	return SI_PROFILED("formula::latus_rectum_of_ellipse", 2.0 * square(b) / a);
 }
 
 // Calculates the shortest distance between two points in 2D.
-length distance(length x1, length y1, length x2, length y2)
+template <class Value = SIdouble>
+constexpr length_t<Value> distance(length_t<Value> x1, length_t<Value> y1, length_t<Value> x2, length_t<Value> y2)
 {
-	const length dx = x2 - x1;
-	const length dy = y2 - y1;
-	return sqrt((dx * dx) + (dy * dy));
+	const length_t<Value> dx = x2 - x1;
+	const length_t<Value> dy = y2 - y1;
+	return SI_PROFILED("formula::distance", sqrt((dx * dx) + (dy * dy)));
 }
 
 // +++ 3D +++
 
 // Calculates the area of a cube from length (a).
-area area_of_cube(length a)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_cube(length_t<Value> a)
 {
-	return 6. * a * a;
+	return SI_PROFILED("formula::area_of_cube", 6. * a * a);
 }
 
 // Calculates the volume of a cube from length (a).
-volume volume_of_cube(length a)
+template <class Value = SIdouble>
+constexpr volume_t<Value> volume_of_cube(length_t<Value> a)
 {
-	return a * a * a;
+	return SI_PROFILED("formula::volume_of_cube", a * a * a);
 }
 
 // Calculates the area of a cylinder from radius (r) and height (h).
-area area_of_cylinder(length r, length h)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_cylinder(length_t<Value> r, length_t<Value> h)
 {
-	return constant::tau * r * (r + h);
+	return SI_PROFILED("formula::area_of_cylinder", constant::tau * r * (r + h));
 }
 
 // Calculates the volume of a cylinder based on radius (r) and height (h).
-volume volume_of_cylinder(length r, length h)
+template <class Value = SIdouble>
+constexpr volume_t<Value> volume_of_cylinder(length_t<Value> r, length_t<Value> h)
 {
-	return constant::pi * square(r) * h;
+	return SI_PROFILED("formula::volume_of_cylinder", constant::pi * square(r) * h);
 }
 
 // Calculates the area of a cone from radius (r) and height (h).
-area area_of_cone(length r, length h)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_cone(length_t<Value> r, length_t<Value> h)
 {
-	return constant::pi * r * (r + h);
+	return SI_PROFILED("formula::area_of_cone", constant::pi * r * (r + h));
 }
 
 // Calculates the volume of a cone from radius (r) and height (h).
-volume volume_of_cone(length r, length h)
+template <class Value = SIdouble>
+constexpr volume_t<Value> volume_of_cone(length_t<Value> r, length_t<Value> h)
 {
-	return (1./3.) * constant::pi * square(r) * h;
+	return SI_PROFILED("formula::volume_of_cone", (1./3.) * constant::pi * square(r) * h);
 }
 
 // Calculates the area of a sphere from radius (r).
-area area_of_sphere(length r)
+template <class Value = SIdouble>
+constexpr area_t<Value> area_of_sphere(length_t<Value> r)
 {
-	return 4. * constant::pi * square(r);
+	return SI_PROFILED("formula::area_of_sphere", 4. * constant::pi * square(r));
 }
 
 // Calculates the volume of a sphere from radius (r).
-volume volume_of_sphere(length r)
+template <class Value = SIdouble>
+constexpr volume_t<Value> volume_of_sphere(length_t<Value> r)
 {
-	return (4. / 3.) * constant::pi * r * r * r;
+	return SI_PROFILED("formula::volume_of_sphere", (4. / 3.) * constant::pi * r * r * r);
 }
 
 // Calculates the volume of a prism from base area (A) and height (h).
-volume volume_of_prism(area A, length h)
+template <class Value = SIdouble>
+constexpr volume_t<Value> volume_of_prism(area_t<Value> A, length_t<Value> h)
 {
-	return A * h;
+	return SI_PROFILED("formula::volume_of_prism", A * h);
 }
 
 // +++ MOVING OBJECTS +++
 
 // Calculates the kinetic energy of a non-rotating object of mass (m) traveling at velocity (v).
-energy kinetic_energy(mass m, velocity v)
+template <class Value = SIdouble>
+constexpr energy_t<Value> kinetic_energy(mass_t<Value> m, velocity_t<Value> v)
 {
-	return 0.5 * m * square(v);
+	return SI_PROFILED("formula::kinetic_energy", 0.5 * m * square(v));
 }
 
-time time_of_free_fall(length height, acceleration gravity)
+template <class Value = SIdouble>
+constexpr time_t<Value> time_of_free_fall(length_t<Value> height, acceleration_t<Value> gravity)
 {
-	return sqrt((2. * height) / gravity);
+	return SI_PROFILED("formula::time_of_free_fall", sqrt((2. * height) / gravity));
 }
 
 // Calculates the braking distance to brake from v0 to v1 with the given deceleration.
-length braking_distance(velocity v0, velocity v1, acceleration deceleration)
+template <class Value = SIdouble>
+constexpr length_t<Value> braking_distance(velocity_t<Value> v0, velocity_t<Value> v1, acceleration_t<Value> deceleration)
 {
-	return (square(v0) - square(v1)) / (2.0 * deceleration);
+	return SI_PROFILED("formula::braking_distance", (square(v0) - square(v1)) / (2.0 * deceleration));
 }
 
 // Calculates the acceleration necessary to accelerate from v0 to v1 within the given distance.
-acceleration acceleration_for_distance(velocity v0, velocity v1, length distance)
+template <class Value = SIdouble>
+constexpr acceleration_t<Value> acceleration_for_distance(velocity_t<Value> v0, velocity_t<Value> v1, length_t<Value> distance)
 {
-	return (square(v1) - square(v0)) / (2.0 * distance);
+	return SI_PROFILED("formula::acceleration_for_distance", (square(v1) - square(v0)) / (2.0 * distance));
 }
 
 // Calculates the final velocity based on initial velocity (i) with acceleration (a) for time (t).
-velocity final_velocity(velocity i, acceleration a, time t)
+template <class Value = SIdouble>
+constexpr velocity_t<Value> final_velocity(velocity_t<Value> i, acceleration_t<Value> a, time_t<Value> t)
 {
-	return i + a * t;
+	return SI_PROFILED("formula::final_velocity", i + a * t);
 }
 
 // Calculate the acceleration from change in velocity (delta_v) and time interval (delta_t).
-acceleration acceleration_of(velocity delta_v, time delta_t)
+template <class Value = SIdouble>
+constexpr acceleration_t<Value> acceleration_of(velocity_t<Value> delta_v, time_t<Value> delta_t)
 {
-	return delta_v / delta_t;
+	return SI_PROFILED("formula::acceleration_of", delta_v / delta_t);
 }
 
 // +++ VEHICLES +++
 // Calculates the turning radius of wheeled vehicles.
-length turning_radius_of_vehicle(length wheelbase, angle steering_angle, length tire_width)
+template <class Value = SIdouble>
+constexpr length_t<Value> turning_radius_of_vehicle(length_t<Value> wheelbase, angle steering_angle, length_t<Value> tire_width)
 {
-	return wheelbase / sin(steering_angle) + tire_width / 2.0;
+	return SI_PROFILED("formula::turning_radius_of_vehicle", wheelbase / sin(steering_angle) + tire_width / 2.0);
 }
 
 // +++ AIRCRAFTS +++
 // Calculates the true airspeed (TAS).
-velocity true_airspeed(force lift_force, dimensionless lift_coefficient, area wing_surface, density air_density)
+template <class Value = SIdouble>
+constexpr velocity_t<Value> true_airspeed(force_t<Value> lift_force, dimensionless lift_coefficient, area_t<Value> wing_surface, density_t<Value> air_density)
 {
-	return sqrt((2.0 * lift_force) / (lift_coefficient * wing_surface * air_density));
+	return SI_PROFILED("formula::true_airspeed", sqrt((2.0 * lift_force) / (lift_coefficient * wing_surface * air_density)));
 }
 
 // Calculates the lift force of an aircraft wing.
-force lift_force_of_wing(dimensionless lift_coefficient, area wing_surface, density air_density, velocity true_air_speed)
+template <class Value = SIdouble>
+constexpr force_t<Value> lift_force_of_wing(dimensionless lift_coefficient, area_t<Value> wing_surface, density_t<Value> air_density, velocity_t<Value> true_air_speed)
 {
-	return 0.5 * air_density * square(true_air_speed) * wing_surface * lift_coefficient;
+	return SI_PROFILED("formula::lift_force_of_wing", 0.5 * air_density * square(true_air_speed) * wing_surface * lift_coefficient);
 }
 
 // Calculate the Mach number from velocity (v) of moving aircraft at altitude's speed of sound.
-dimensionless Mach_number(velocity v, velocity speed_of_sound)
+template <class Value = SIdouble>
+constexpr Value Mach_number(velocity_t<Value> v, velocity_t<Value> speed_of_sound)
 {
-	return v / speed_of_sound;
+	return SI_PROFILED("formula::Mach_number", v / speed_of_sound);
 }
 
 // Calculate the glide path from horizontal distance (h) and vertical change (v).
-angle glide_path(length h, length v)
+template <class Value = SIdouble>
+constexpr angle glide_path(length_t<Value> h, length_t<Value> v)
 {
-	return atan2(v, h);
+	return SI_PROFILED("formula::glide_path", atan2(v, h));
 }
 
-length vertical_height(angle glide_path, length horizontal_distance)
+template <class Value = SIdouble>
+constexpr length_t<Value> vertical_height(angle glide_path, length_t<Value> horizontal_distance)
 {
-	return horizontal_distance * tan(glide_path);
+	return SI_PROFILED("formula::vertical_height", horizontal_distance * tan(glide_path));
 }
 
-velocity climb_rate(velocity ground_speed, angle climb_angle)
+template <class Value = SIdouble>
+constexpr velocity_t<Value> climb_rate(velocity_t<Value> ground_speed, angle climb_angle)
 {
-	return sin(climb_angle) * ground_speed;
+	return SI_PROFILED("formula::climb_rate", sin(climb_angle) * ground_speed);
 }
 
 // +++ GRAVITATION +++
 
 // Calculates the gravitational potential energy of a mass (m) at height (h) based on gravity (e.g. on Earth).
-energy gravitational_potential_energy(mass m, length h, acceleration gravity)
+template <class Value = SIdouble>
+constexpr energy_t<Value> gravitational_potential_energy(mass_t<Value> m, length_t<Value> h, acceleration_t<Value> gravity)
 {
-	return m * h * gravity;
+	return SI_PROFILED("formula::gravitational_potential_energy", m * h * gravity);
 }
 
 // Calculates the attractive force between two bodies of masses (m1) and (m2) with distance (d) between their centres of mass.
-force gravitational_attractive_force(mass m1, mass m2, length d)
+template <class Value = SIdouble>
+constexpr force_t<Value> gravitational_attractive_force(mass_t<Value> m1, mass_t<Value> m2, length_t<Value> d)
 {
-	return (constant::G * m1 * m2) / square(d);
+	return SI_PROFILED("formula::gravitational_attractive_force", (constant::G * m1 * m2) / square(d));
 }
 
 // Calculates the escape velocity from a Mass (M) of body (e.g. a planet) with radius of body (r).
-velocity gravitational_escape_velocity(mass M, length r)
+template <class Value = SIdouble>
+constexpr velocity_t<Value> gravitational_escape_velocity(mass_t<Value> M, length_t<Value> r)
 {
-	return sqrt((2.0 * constant::G * M) / r);
+	return SI_PROFILED("formula::gravitational_escape_velocity", sqrt((2.0 * constant::G * M) / r));
 }
 
 // Calculates the flattening factor (f) of an astronomical object from radius to equator (Re) and radius to pole (Rp).
-dimensionless flattening_factor(length Re, length Rp)
+template <class Value = SIdouble>
+constexpr Value flattening_factor(length_t<Value> Re, length_t<Value> Rp)
 {
-	return (Re - Rp) / Re;
+	return SI_PROFILED("formula::flattening_factor", (Re - Rp) / Re);
 }
 
 // Calculates the theoretical local gravity at latitude (lat) and height above MSL (h).
-acceleration local_gravity(angle lat, length h)
+template <class Value = SIdouble>
+constexpr acceleration_t<Value> local_gravity(angle lat, length_t<Value> h)
 {
 	auto IGF = 9.780327_m_per_s² * (1.0 + 0.0053024 * sin2(lat) - 0.0000058 * sin2(2.0 * lat)); // International Gravity Formula
 	auto FAC = -3.086e-6_m_per_s² * meters(h); // Free Air Correction
-	return IGF + FAC;
+	return SI_PROFILED("formula::local_gravity", IGF + FAC);
 }
 
 // +++ VARIOUS FORMULAS +++
 
 // Calculates the wavelength from velocity (v) and frequency (f).
-length wavelength(velocity v, frequency f)
+template <class Value = SIdouble>
+constexpr length_t<Value> wavelength(velocity_t<Value> v, frequency_t<Value> f)
 {
-	return v / f;
+	return SI_PROFILED("formula::wavelength", v / f);
 }
 
 // Calculates the speed of sound in air based on temperature (T).
-velocity speed_of_sound_in_air(temperature T)
+template <class Value = SIdouble>
+constexpr velocity_t<Value> speed_of_sound_in_air(temperature_t<Value> T)
 {
 	double adiabatic_index = 1.4; // for air
 	auto M = 0.0289645_kg_per_mol; // molar mass of the gas
-	return sqrt((adiabatic_index * constant::R * T) / M);
+	return SI_PROFILED("formula::speed_of_sound_in_air", sqrt((adiabatic_index * constant::R * T) / M));
 }
 
 // Calculates the drag force based on mass density of the fluid (p), flow velocity (u), drag coefficient (cd) and reference area (A).
-force drag_in_fluid(density p, velocity u, dimensionless cd, area A)
+template <class Value = SIdouble>
+constexpr force_t<Value> drag_in_fluid(density_t<Value> p, velocity_t<Value> u, dimensionless cd, area_t<Value> A)
 {
-	return 0.5 * p * (u * u) * cd * A;
+	return SI_PROFILED("formula::drag_in_fluid", 0.5 * p * (u * u) * cd * A);
 }
 
-frequency frequency_of_chromatic_note(int note, int reference_note, frequency reference_frequency)
+template <class Value = SIdouble>
+constexpr frequency_t<Value> frequency_of_chromatic_note(int note, int reference_note, frequency_t<Value> reference_frequency)
 {
-	return std::pow(std::pow(2., 1. / 12.), note - reference_note) * reference_frequency;
+	return SI_PROFILED("formula::frequency_of_chromatic_note", constexpr_math::pow(constexpr_math::pow(2., 1. / 12.), note - reference_note) * reference_frequency);
 }
 
-auto Newtons_motion(length s0, velocity v0, acceleration a, time t)
+template <class Value = SIdouble>
+constexpr auto Newtons_motion(length_t<Value> s0, velocity_t<Value> v0, acceleration_t<Value> a, time_t<Value> t)
 {
-	return s0 + v0 * t + 0.5 * a * t * t;
+	return SI_PROFILED("formula::Newtons_motion", s0 + v0 * t + 0.5 * a * t * t);
 }
 
 // Calculates the Lorentz force.
-auto Lorentz_force(double q, velocity v, double B)
+template <class Value = SIdouble>
+constexpr auto Lorentz_force(double q, velocity_t<Value> v, double B)
 {
-	return q * v * B;
+	return SI_PROFILED("formula::Lorentz_force", q * v * B);
 }
 
 // Calculates the windchill temperature.
-temperature windchill_temperature(temperature air_temperature, velocity wind_speed)
+template <class Value = SIdouble>
+constexpr temperature_t<Value> windchill_temperature(temperature_t<Value> air_temperature, velocity_t<Value> wind_speed)
 {
+	using constexpr_math::pow;
 	auto air_celsius = celsius(air_temperature);
-	return celsius(13.12 + 0.6215 * air_celsius
-	  + (0.3965 * air_celsius - 11.37) * std::pow(wind_speed / 1_km_per_h, 0.16));
+	return SI_PROFILED("formula::windchill_temperature", celsius(13.12 + 0.6215 * air_celsius
+	  + (0.3965 * air_celsius - 11.37) * pow(wind_speed / 1_km_per_h, 0.16)));
 }
 
 // Calculates the density of dry air.
-density density_of_dry_air(pressure air_pressure, temperature air_temperature)
+template <class Value = SIdouble>
+constexpr density_t<Value> density_of_dry_air(pressure_t<Value> air_pressure, temperature_t<Value> air_temperature)
 {
-	return air_pressure / (constant::R_dry_air * air_temperature);
+	return SI_PROFILED("formula::density_of_dry_air", air_pressure / (constant::R_dry_air * air_temperature));
 }
 
 // Calculates the density from mass (m) and volume (V).
-density density_of(mass m, volume V)
+template <class Value = SIdouble>
+constexpr density_t<Value> density_of(mass_t<Value> m, volume_t<Value> V)
 {
-	return m / V;
+	return SI_PROFILED("formula::density_of", m / V);
 }
 
 // Calculates the mass from density (p) and volume (V).
-mass mass_of(density p, volume V)
+template <class Value = SIdouble>
+constexpr mass_t<Value> mass_of(density_t<Value> p, volume_t<Value> V)
 {
-	return p * V;
+	return SI_PROFILED("formula::mass_of", p * V);
 }
 
 // Calculates the volume from mass (m) and density (p).
-volume volume_of(mass m, density p)
+template <class Value = SIdouble>
+constexpr volume_t<Value> volume_of(mass_t<Value> m, density_t<Value> p)
 {
-	return m / p;
+	return SI_PROFILED("formula::volume_of", m / p);
 }
 
 // Calculates the body-mass index (BMI).
-dimensionless BMI(mass weight, length height)
+template <class Value = SIdouble>
+constexpr Value BMI(mass_t<Value> weight, length_t<Value> height)
 {
-	return (weight / square(height)) / 1_kg_per_m²;
+	return SI_PROFILED("formula::BMI", (weight / square(height)) / 1_kg_per_m²);
 }
 
-auto consumed_electrical_power(electric_current I, electric_potential U)
+template <class Value = SIdouble>
+constexpr auto consumed_electrical_power(electric_current_t<Value> I, electric_potential_t<Value> U)
 {
-	return I * U;
+	return SI_PROFILED("formula::consumed_electrical_power", I * U);
 }
 
-auto sound_intensity(power power_of_sound_source, length distance_from_sound_source)
+template <class Value = SIdouble>
+constexpr auto sound_intensity(power_t<Value> power_of_sound_source, length_t<Value> distance_from_sound_source)
 {
-	return power_of_sound_source / (4.0 * constant::pi * square(distance_from_sound_source));
+	return SI_PROFILED("formula::sound_intensity", power_of_sound_source / (4.0 * constant::pi * square(distance_from_sound_source)));
 }
 
 // Calculates the max height of a bullet (without force of drag, wind, etc.), based on:
 // initial launch velocity (v0), initial height (h), launch angle (a), and gravitation (g).
-length ballistic_max_height(velocity v0, length h, angle a, acceleration g)
+template <class Value = SIdouble>
+constexpr length_t<Value> ballistic_max_height(velocity_t<Value> v0, length_t<Value> h, angle a, acceleration_t<Value> g)
 {
-	return h + square(v0 * sin(a)) / (2.0 * g);
+	return SI_PROFILED("formula::ballistic_max_height", h + square(v0 * sin(a)) / (2.0 * g));
 }
 
 // Calculates the max range of a bullet (without force of drag, wind, etc.), based on:
 // initial launch velocity (v0), initial height (h), launch angle (a), and gravitation (g).
-length ballistic_max_range(velocity v0, length h, angle a, acceleration g)
+template <class Value = SIdouble>
+constexpr length_t<Value> ballistic_max_range(velocity_t<Value> v0, length_t<Value> h, angle a, acceleration_t<Value> g)
 {
-	return ((v0 * sin(a) + sqrt(square(v0 * sin(a)) + 2.0 * g * h)) / g) * cos(a) * v0;
+	return SI_PROFILED("formula::ballistic_max_range", ((v0 * sin(a) + sqrt(square(v0 * sin(a)) + 2.0 * g * h)) / g) * cos(a) * v0);
 }
 
 // Calculates the flight time of a bullet (without force of drag, wind, etc.), based on:
 // initial launch velocity (v0), initial height (h), launch angle (a), and gravitation (g).
-time ballistic_travel_time(velocity v0, length h, angle a, acceleration g)
+template <class Value = SIdouble>
+constexpr time_t<Value> ballistic_travel_time(velocity_t<Value> v0, length_t<Value> h, angle a, acceleration_t<Value> g)
 {
-	return (v0 * sin(a) + sqrt(square(v0 * sin(a)) + 2.0 * g * h)) / g;
+	return SI_PROFILED("formula::ballistic_travel_time", (v0 * sin(a) + sqrt(square(v0 * sin(a)) + 2.0 * g * h)) / g);
 }
 
 // Calculates the amount of energy absorbed (E) from a source of radiation by some material per mass (m)
-specific_energy absorbed_dose(energy E, mass m)
+template <class Value = SIdouble>
+constexpr specific_energy_t<Value> absorbed_dose(energy_t<Value> E, mass_t<Value> m)
 {
-	return E / m;
+	return SI_PROFILED("formula::absorbed_dose", E / m);
 }
 
 } } // namespace SI::formula
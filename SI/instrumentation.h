@@ -0,0 +1,243 @@
+// <SI/instrumentation.h> - call counts and cycles of formulas and conversions, e.g. std::puts(SI::instrumentation::to_json().c_str())
+//                         (compiled in by defining SI_INSTRUMENTATION, else the counting compiles to nothing)
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <SI/constexpr_math.h>
+#if defined(SI_INSTRUMENTATION) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+namespace SI { namespace instrumentation {
+
+#ifdef SI_INSTRUMENTATION
+	namespace detail
+	{
+		constexpr size_t max_sites = 1024; // (instrumented functions, counted per template instantiation)
+
+		struct counter
+		{
+			std::atomic<uint64_t> calls{ 0 };
+			std::atomic<uint64_t> cycles{ 0 };
+		};
+
+		// the counters of a thread, written by this thread only (so without atomic read-modify-writes) and read by
+		// to_json() from any thread. When the thread exits, its counts move into the retired counters and the block is
+		// reused by the next new thread, so there are only as many blocks as threads ever ran at the same time.
+		struct thread_counters
+		{
+			counter sites[max_sites];
+			thread_counters* next = nullptr; // (in all_threads, blocks are never removed from it)
+		};
+
+		inline std::atomic<const char*> site_names[max_sites];
+		inline std::atomic<size_t> site_count{ 0 };
+		inline std::atomic<thread_counters*> all_threads{ nullptr };
+		inline counter retired[max_sites]; // (the counts of exited threads)
+		inline std::mutex free_blocks_mutex; // (taken on thread start and exit only)
+		inline std::vector<thread_counters*> free_blocks;
+
+		inline size_t register_site(const char* name)
+		{
+			const size_t site = site_count.fetch_add(1);
+			assert(site < max_sites); // (else increase max_sites)
+			if (site < max_sites)
+				site_names[site].store(name, std::memory_order_release);
+			return site;
+		}
+
+		inline thread_counters* acquire_block()
+		{
+			{
+				const std::lock_guard<std::mutex> lock(free_blocks_mutex);
+				if (!free_blocks.empty())
+				{
+					thread_counters* c = free_blocks.back();
+					free_blocks.pop_back();
+					return c;
+				}
+			}
+			auto* c = new thread_counters;
+			c->next = all_threads.load();
+			while (!all_threads.compare_exchange_weak(c->next, c)) {} // (a lock-free push)
+			return c;
+		}
+
+		inline void retire_block(thread_counters* c)
+		{
+			const size_t sites = std::min(site_count.load(), max_sites);
+			for (size_t site = 0; site < sites; site++) // (moved, so to_json() never counts them twice)
+			{
+				retired[site].calls.fetch_add(c->sites[site].calls.exchange(0));
+				retired[site].cycles.fetch_add(c->sites[site].cycles.exchange(0));
+			}
+			const std::lock_guard<std::mutex> lock(free_blocks_mutex);
+			free_blocks.push_back(c);
+		}
+
+		// owns the counters of a thread until it exits
+		struct thread_block
+		{
+			thread_counters* counters = acquire_block();
+			thread_block() = default;
+			~thread_block() { retire_block(counters); }
+			thread_block(const thread_block&) = delete;
+			thread_block& operator=(const thread_block&) = delete;
+		};
+
+		inline thread_counters& counters_of_this_thread()
+		{
+			thread_local thread_block block;
+			return *block.counters;
+		}
+
+		inline thread_local bool in_batch = false; // (then the formulas are counted per batch instead of per element)
+
+		// the time stamp counter on x86 (in cycles), else the steady clock (in nanoseconds)
+		inline uint64_t cycles()
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+		}
+
+		inline void count(size_t site, uint64_t cycles, uint64_t calls = 1)
+		{
+			if (site >= max_sites)
+				return;
+			counter& c = counters_of_this_thread().sites[site];
+			c.calls.store(c.calls.load(std::memory_order_relaxed) + calls, std::memory_order_relaxed);
+			c.cycles.store(c.cycles.load(std::memory_order_relaxed) + cycles, std::memory_order_relaxed);
+		}
+
+		// counts the lifetime of the scope, see SI_PROFILE_SCOPE
+		class scope
+		{
+		public:
+			explicit scope(size_t site) : m_site(site), m_start(cycles()) {}
+			~scope() { count(m_site, cycles() - m_start); }
+			scope(const scope&) = delete;
+			scope& operator=(const scope&) = delete;
+
+		private:
+			size_t m_site;
+			uint64_t m_start;
+		};
+
+		// counts the lifetime of the scope as the given number of calls of a batch, see SI_PROFILE_BATCH
+		class batch_scope
+		{
+		public:
+			batch_scope(size_t site, size_t count) : m_site(site), m_count(count), m_start(cycles()) {}
+			~batch_scope() { count(m_site, cycles() - m_start, m_count); }
+			batch_scope(const batch_scope&) = delete;
+			batch_scope& operator=(const batch_scope&) = delete;
+
+		private:
+			size_t m_site, m_count;
+			uint64_t m_start;
+		};
+
+		// stops counting the formulas called per element in the scope (in all threads working on a batch)
+		class unprofiled_scope
+		{
+		public:
+			unprofiled_scope() : m_was_in_batch(in_batch) { in_batch = true; }
+			~unprofiled_scope() { in_batch = m_was_in_batch; }
+			unprofiled_scope(const unprofiled_scope&) = delete;
+			unprofiled_scope& operator=(const unprofiled_scope&) = delete;
+
+		private:
+			bool m_was_in_batch;
+		};
+
+		template <class Function> // (a site per lambda, i.e. per instrumented function)
+		auto profiled_at_runtime(const char* name, const Function& function)
+		{
+			if (in_batch)
+				return function();
+			static const size_t site = register_site(name);
+			const scope counted(site);
+			return function();
+		}
+
+		// Evaluates the function, counting it at run-time only (constexpr functions can't hold a scope in C++17).
+		template <class Function>
+		constexpr auto profiled(const char* name, const Function& function)
+		{
+			if (SI_IS_CONSTANT_EVALUATED())
+				return function();
+			return profiled_at_runtime(name, function);
+		}
+	}
+
+	// Returns the call counts and cycles of all instrumented functions called so far by any thread as a JSON array,
+	// sorted by cycles, e.g. [{"function": "formula::kinetic_energy", "calls": 1000, "cycles": 23000}, ...]. Counting
+	// goes on meanwhile, so the counts of other threads may be a few calls behind.
+	inline std::string to_json(size_t max_functions = size_t(-1))
+	{
+		struct entry { std::string function; uint64_t calls, cycles; };
+		std::vector<entry> entries;
+		const size_t sites = std::min(detail::site_count.load(), detail::max_sites);
+		for (size_t site = 0; site < sites; site++)
+		{
+			const char* name = detail::site_names[site].load(std::memory_order_acquire);
+			if (name == nullptr)
+				continue; // (still being registered)
+			uint64_t calls = detail::retired[site].calls.load(std::memory_order_relaxed);
+			uint64_t cycles = detail::retired[site].cycles.load(std::memory_order_relaxed);
+			for (auto* counters = detail::all_threads.load(); counters != nullptr; counters = counters->next)
+			{
+				calls += counters->sites[site].calls.load(std::memory_order_relaxed);
+				cycles += counters->sites[site].cycles.load(std::memory_order_relaxed);
+			}
+			auto it = std::find_if(entries.begin(), entries.end(), [&](const entry& e) { return e.function == name; });
+			if (it == entries.end())
+				entries.push_back({ name, calls, cycles }); // (template instantiations are summed up by name)
+			else
+				it->calls += calls, it->cycles += cycles;
+		}
+		std::stable_sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) { return a.cycles > b.cycles; });
+
+		std::string json = "[";
+		for (size_t i = 0; i < entries.size() && i < max_functions; i++)
+			json += (i == 0 ? "{\"function\": \"" : ", {\"function\": \"") + entries[i].function + "\", \"calls\": "
+				+ std::to_string(entries[i].calls) + ", \"cycles\": " + std::to_string(entries[i].cycles) + "}";
+		return json + "]";
+	}
+
+	// Evaluates the expression of a (constexpr) function and counts it, e.g. return SI_PROFILED("formula::BMI", m / (h * h));
+#define SI_PROFILED(_name, ...) SI::instrumentation::detail::profiled(_name, [&] { return (__VA_ARGS__); })
+	// Counts the rest of the scope of a (non-constexpr) function, e.g. SI_PROFILE_SCOPE("to_string(angle)");
+#define SI_PROFILE_SCOPE(_name) static const size_t si_site_ = SI::instrumentation::detail::register_site(_name); \
+	const SI::instrumentation::detail::scope si_scope_(si_site_)
+	// Counts the rest of the scope as _count calls, e.g. of a batched formula (which counts the elements with SI_UNPROFILED_SCOPE).
+#define SI_PROFILE_BATCH(_name, _count) static const size_t si_site_ = SI::instrumentation::detail::register_site(_name); \
+	const SI::instrumentation::detail::batch_scope si_scope_(si_site_, _count)
+#define SI_UNPROFILED_SCOPE() const SI::instrumentation::detail::unprofiled_scope si_unprofiled_
+#else
+	inline std::string to_json(size_t = size_t(-1))
+	{
+		return "[]"; // (nothing counted without SI_INSTRUMENTATION)
+	}
+
+#define SI_PROFILED(_name, ...) (__VA_ARGS__)
+#define SI_PROFILE_SCOPE(_name)
+#define SI_PROFILE_BATCH(_name, _count)
+#define SI_UNPROFILED_SCOPE()
+#endif
+
+} } // namespace SI::instrumentation
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Time_Stamp_Counter
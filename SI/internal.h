@@ -4,6 +4,10 @@
 #include <utility>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <SI/constexpr_math.h>
 
 #define SI_INLINE inline 
 #define SI_INLINE_CONSTEXPR constexpr SI_INLINE
@@ -108,6 +112,9 @@ namespace SI
 		template <class T> using vec2 = vec<2, T>;
 		template <class T> using vec3 = vec<3, T>;
 
+		// enables operators of other value types (e.g. intervals) with plain scalars
+		template <class T> using enable_for_scalar = std::enable_if_t<std::is_arithmetic_v<T>>;
+
 		// unary operators
 		template <class T> [[nodiscard]] SI_INLINE_CONSTEXPR vec2<T> operator-(const vec2<T>& v) { return { -v.x, -v.y }; }
 		template <class T> [[nodiscard]] SI_INLINE_CONSTEXPR vec3<T> operator-(const vec3<T>& v) { return { -v.x, -v.y, -v.z }; }
@@ -226,6 +233,65 @@ namespace SI
 		template <class T>
 		using vec3 = internal::vec3<T>;
 
+#ifdef SI_PACKED_DIMENSIONS
+		// Returns the 7 dimensional exponents packed into one integer of 8 bits each (from length in the lowest byte to
+		// intensity in the highest but one), exponents must be in [-128, 127].
+		constexpr uint64_t pack_exponents(long length, long mass, long time, long temperature, long current, long substance, long intensity)
+		{
+			const long exponents[] = { length, mass, time, temperature, current, substance, intensity };
+			uint64_t code = 0;
+			for (int i = 0; i < 7; i++)
+				code |= uint64_t(exponents[i] >= -128 && exponents[i] <= 127 ? exponents[i] & 0xFF : throw "dimensional exponent out of range") << (8 * i);
+			return code;
+		}
+
+		constexpr long unpack_exponent(uint64_t code, int index)
+		{
+			return static_cast<int8_t>((code >> (8 * index)) & 0xFF);
+		}
+
+		// Adds or subtracts the exponents of two packed dimensions bytewise in one step (SIMD within a register: the
+		// highest bit of each byte is handled apart, so no carry crosses into the next exponent).
+		constexpr uint64_t high_bits = 0x0080808080808080;
+
+		constexpr uint64_t combine_exponents(uint64_t lhs, uint64_t rhs, std::plus<long>)
+		{
+			return ((lhs & ~high_bits) + (rhs & ~high_bits)) ^ ((lhs ^ rhs) & high_bits);
+		}
+
+		constexpr uint64_t combine_exponents(uint64_t lhs, uint64_t rhs, std::minus<long>)
+		{
+			return ((lhs | high_bits) - (rhs & ~high_bits)) ^ ((lhs ^ ~rhs) & high_bits);
+		}
+
+		// Combines the exponents of two packed dimensions pairwise, e.g. by std::multiplies for pow<N>().
+		template <class Operation>
+		constexpr uint64_t combine_exponents(uint64_t lhs, uint64_t rhs, Operation operation)
+		{
+			return pack_exponents(operation(unpack_exponent(lhs, 0), unpack_exponent(rhs, 0)), operation(unpack_exponent(lhs, 1), unpack_exponent(rhs, 1)),
+				operation(unpack_exponent(lhs, 2), unpack_exponent(rhs, 2)), operation(unpack_exponent(lhs, 3), unpack_exponent(rhs, 3)),
+				operation(unpack_exponent(lhs, 4), unpack_exponent(rhs, 4)), operation(unpack_exponent(lhs, 5), unpack_exponent(rhs, 5)),
+				operation(unpack_exponent(lhs, 6), unpack_exponent(rhs, 6)));
+		}
+
+		// the dimension(s) of a physical quantity, packed into one template argument (shorter symbol names and fewer
+		// template arguments to instantiate than the 7 longs below, enabled by defining SI_PACKED_DIMENSIONS)
+		template <uint64_t Code>
+		struct packed_dimension
+		{
+			static constexpr uint64_t code = Code;
+			static constexpr long length = unpack_exponent(Code, 0);
+			static constexpr long mass = unpack_exponent(Code, 1);
+			static constexpr long time = unpack_exponent(Code, 2);
+			static constexpr long temperature = unpack_exponent(Code, 3);
+			static constexpr long current = unpack_exponent(Code, 4);
+			static constexpr long substance = unpack_exponent(Code, 5);
+			static constexpr long intensity = unpack_exponent(Code, 6);
+		};
+
+		template <long lengthExp, long massExp, long timeExp, long temperatureExp, long currentExp, long substanceExp, long intensityExp>
+		using dimension = packed_dimension<pack_exponents(lengthExp, massExp, timeExp, temperatureExp, currentExp, substanceExp, intensityExp)>;
+#else
 		// the dimension(s) of a physical quantity, specified by it's dimensional exponents.
 		template <long lengthExp, long massExp, long timeExp, long temperatureExp, long currentExp, long substanceExp, long intensityExp>
 		struct dimension
@@ -238,6 +304,7 @@ namespace SI
 			static constexpr long substance = substanceExp;
 			static constexpr long intensity = intensityExp;
 		};
+#endif
 
 		template <long Value>
 		using value_dimension = dimension<Value, Value, Value, Value, Value, Value, Value>;
@@ -256,11 +323,19 @@ namespace SI
 			using type = dimensionless;
 		};
 
+#ifdef SI_PACKED_DIMENSIONS
+		template <uint64_t Code>
+		struct dimension_of<packed_dimension<Code>>
+		{
+			using type = packed_dimension<Code>;
+		};
+#else
 		template <long Length, long Mass, long Time, long Temperature, long Current, long Substance, long Intensity>
 		struct dimension_of<dimension<Length, Mass, Time, Temperature, Current, Substance, Intensity>>
 		{
 			using type = dimension<Length, Mass, Time, Temperature, Current, Substance, Intensity>;
 		};
+#endif
 
 		template <class Dimension, class T>
 		struct dimension_of<quantity<Dimension, T>>
@@ -282,7 +357,10 @@ namespace SI
 		template <class T>
 		SI_INLINE_CONSTEXPR bool is_dimensionless_v = std::is_same_v<dimensionless, dimension_of_t<T>>;
 
-#define SI_DIMENSION_OP(op_) dimension<                        \
+#ifdef SI_PACKED_DIMENSIONS
+#define SI_DIMENSION_OP(op_, function_) packed_dimension<combine_exponents(Lhs::code, Rhs::code, function_<long>())>
+#else
+#define SI_DIMENSION_OP(op_, function_) dimension<   \
 			Lhs::length op_ Rhs::length,           \
 			Lhs::mass op_ Rhs::mass,               \
 			Lhs::time op_ Rhs::time,               \
@@ -290,11 +368,12 @@ namespace SI
 			Lhs::current op_ Rhs::current,         \
 			Lhs::substance op_ Rhs::substance,     \
 			Lhs::intensity op_ Rhs::intensity>
+#endif
 
-		template <class Lhs, class Rhs> using dimension_add_impl = SI_DIMENSION_OP(+);
-		template <class Lhs, class Rhs> using dimension_subtract_impl = SI_DIMENSION_OP(-);
-		template <class Lhs, class Rhs> using dimension_multiply_impl = SI_DIMENSION_OP(*);
-		template <class Lhs, class Rhs> using dimension_divide_impl = SI_DIMENSION_OP(/);
+		template <class Lhs, class Rhs> using dimension_add_impl = SI_DIMENSION_OP(+, std::plus);
+		template <class Lhs, class Rhs> using dimension_subtract_impl = SI_DIMENSION_OP(-, std::minus);
+		template <class Lhs, class Rhs> using dimension_multiply_impl = SI_DIMENSION_OP(*, std::multiplies);
+		template <class Lhs, class Rhs> using dimension_divide_impl = SI_DIMENSION_OP(/, std::divides);
 
 		template <class Lhs, class Rhs> using dimension_add = dimension_add_impl <dimension_of_t<Lhs>, dimension_of_t<Rhs>>;
 		template <class Lhs, class Rhs> using dimension_subtract = dimension_subtract_impl <dimension_of_t<Lhs>, dimension_of_t<Rhs>>;
@@ -305,6 +384,9 @@ namespace SI
 
 		struct zero_t {};
 
+		template <class T> struct identity { using type = T; };
+		template <class T> using identity_t = typename identity<T>::type; // (prevents template argument deduction)
+
 		template <class T> struct scalar_value_type { using type = T; };
 		template <> struct scalar_value_type<zero_t> { using type = int; };
 		template <class Dimension, class T> struct scalar_value_type<quantity<Dimension, T>> { using type = typename scalar_value_type<T>::type; };
@@ -318,7 +400,7 @@ namespace SI
 		{
 		public:
 			SI_INLINE_CONSTEXPR quantity_storage()
-				: m_value(0)
+				: m_value()
 			{}
 
 			SI_INLINE_CONSTEXPR explicit operator bool() const
@@ -418,7 +500,7 @@ namespace SI
 		// Helper function for arithmetic functions with two arguments, returns the value of the first argument but uses
 		// the second argument to deduce the returned type in case of si::zero
 		template <class T, class U>
-		SI_INLINE_CONSTEXPR decltype(auto) value2(T&& x, U)
+		SI_INLINE_CONSTEXPR decltype(auto) value2(T&& x, const U&)
 		{
 			return value(std::forward<T>(x));
 		}
@@ -561,7 +643,10 @@ namespace SI
 		template <class Dimension, class T>
 		SI_INLINE_CONSTEXPR quantity<Dimension, T> abs(const quantity<Dimension, T>& x)
 		{
-			return value(x) < 0.0 ? -x : x;
+			if constexpr (std::is_arithmetic_v<T>)
+				return value(x) < 0.0 ? -x : x;
+			else
+				return { Dimension(), abs(value(x)) }; // (componentwise for vectors, of both bounds for intervals)
 		}
 
 		template <class Lhs, class Rhs, class = enable_for_si<Lhs, Rhs>>
@@ -571,6 +656,13 @@ namespace SI
 			SI_RETURN_QUANTITY(result_dimension, dot(value(lhs), value(rhs)));
 		}
 
+		template <class Lhs, class Rhs, class = enable_for_si<Lhs, Rhs>>
+		SI_INLINE_CONSTEXPR auto cross(const Lhs& lhs, const Rhs& rhs)
+		{
+			using result_dimension = dimension_add<Lhs, Rhs>;
+			SI_RETURN_QUANTITY(result_dimension, cross(value(lhs), value(rhs)));
+		}
+
 		template <class Dimension, class T>
 		SI_INLINE auto normalize(const quantity<Dimension, T>& x)
 		{
@@ -589,28 +681,73 @@ namespace SI
 			return quantity{ dimension<1, 0, 0, 0, 0, 0, 0>(), distance(value(a), value(b)) };
 		}
 
+		// Returns x to the power of the exponent by squaring, unrolled at compile-time (e.g. x⁵ = (x²)²·x, no libm call).
+		template <long Exponent, class T>
+		SI_INLINE_CONSTEXPR T integer_pow(const T& x)
+		{
+			if constexpr (Exponent < 0)
+				return T(1) / integer_pow<-Exponent>(x);
+			else if constexpr (Exponent == 0)
+				return T(1);
+			else if constexpr (Exponent == 1)
+				return x;
+			else if constexpr (Exponent % 2 == 0)
+			{
+				const T half = integer_pow<Exponent / 2>(x);
+				return half * half;
+			}
+			else
+				return integer_pow<Exponent - 1>(x) * x;
+		}
+
 		template <long Exponent, class Dimension, class T>
-		SI_INLINE auto pow(const quantity<Dimension, T>& x)
+		SI_INLINE_CONSTEXPR auto pow(const quantity<Dimension, T>& x)
 		{
-			using std::pow;
+			using constexpr_math::pow;
 			using result_dimension = dimension_multiply<Dimension, value_dimension<Exponent>>;
-			SI_RETURN_QUANTITY(result_dimension, pow(value(x), Exponent));
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				SI_RETURN_QUANTITY(result_dimension, integer_pow<Exponent>(value(x)));
+			}
+			else // (value types like intervals know better, e.g. x² of [-1, 2] is [0, 4] but x·x is [-2, 4])
+			{
+				SI_RETURN_QUANTITY(result_dimension, pow(value(x), Exponent));
+			}
 		}
 
 		template <long Degree, class Dimension, class T>
-		SI_INLINE auto root(const quantity<Dimension, T>& x)
+		SI_INLINE_CONSTEXPR auto root(const quantity<Dimension, T>& x)
 		{
-			using std::pow;
+			using constexpr_math::pow;
+			using constexpr_math::sqrt;
+			using constexpr_math::cbrt;
 			using result_dimension = dimension_divide<Dimension, value_dimension<Degree>>;
 			static_assert(std::is_same_v<dimension_multiply<result_dimension, value_dimension<Degree>>, Dimension>, "cannot take root of this SI dimension");
 
-			SI_RETURN_QUANTITY(result_dimension, pow(value(x), 1. / Degree));
+			if constexpr (Degree == 2)
+			{
+				SI_RETURN_QUANTITY(result_dimension, sqrt(value(x)));
+			}
+			else if constexpr (Degree == 3 && std::is_floating_point_v<T>)
+			{
+				SI_RETURN_QUANTITY(result_dimension, cbrt(value(x))); // (exact for cubes, negative x allowed)
+			}
+			else
+			{
+				SI_RETURN_QUANTITY(result_dimension, pow(value(x), 1. / Degree));
+			}
+		}
+
+		template <class Dimension, class T>
+		SI_INLINE_CONSTEXPR auto cbrt(const quantity<Dimension, T>& x)
+		{
+			return root<3>(x);
 		}
 
 		template <class Dimension, class T>
-		SI_INLINE auto sqrt(const quantity<Dimension, T>& x)
+		SI_INLINE_CONSTEXPR auto sqrt(const quantity<Dimension, T>& x)
 		{
-			using std::sqrt;
+			using constexpr_math::sqrt;
 			using result_dimension = dimension_divide<Dimension, value_dimension<2>>;
 			static_assert(std::is_same_v<dimension_multiply<result_dimension, value_dimension<2>>, Dimension>, "cannot take sqrt of this SI dimension");
 
@@ -640,27 +777,77 @@ namespace SI
 			SI_RETURN_QUANTITY(result_dimension, std::clamp(value(x), value(min), value(max)));
 		}
 
-		template <long Num, long Den>
+		// exact unit ratio (Num / Den), converted to floating point only once
+		template <std::intmax_t Num, std::intmax_t Den>
 		struct ratio
 		{
+			static constexpr std::intmax_t num = Num;
+			static constexpr std::intmax_t den = Den;
+			static constexpr bool exact = true;
 			static constexpr auto factor = static_cast<SIdouble>(Num) / Den;
 		};
 
+		// fallback for ratios whose numerator or denominator would overflow
+		template <class Lhs, class Rhs, bool Multiply>
+		struct inexact_ratio
+		{
+			static constexpr bool exact = false;
+			static constexpr auto factor = Multiply ? Lhs::factor * Rhs::factor : Lhs::factor / Rhs::factor;
+		};
+
 		struct tag_celsius {};
 		struct tag_fahrenheit {};
 
+		SI_INLINE_CONSTEXPR bool ratio_fits(std::intmax_t a, std::intmax_t b)
+		{
+			return a == 0 || b == 0 || ((a < 0 ? -a : a) <= std::numeric_limits<std::intmax_t>::max() / (b < 0 ? -b : b));
+		}
+
+		// multiplies (N1 / D1) * (N2 / D2) with rational arithmetic, cross-reducing first like std::ratio_multiply
+		template <class Lhs, class Rhs, std::intmax_t N1, std::intmax_t D1, std::intmax_t N2, std::intmax_t D2, bool Multiply>
+		struct ratio_multiply
+		{
+			static constexpr std::intmax_t g1 = std::gcd(N1, D2);
+			static constexpr std::intmax_t g2 = std::gcd(N2, D1);
+			static constexpr bool fits = ratio_fits(N1 / g1, N2 / g2) && ratio_fits(D1 / g2, D2 / g1);
+			static constexpr std::intmax_t num = fits ? (N1 / g1) * (N2 / g2) : 1;
+			static constexpr std::intmax_t den = fits ? (D1 / g2) * (D2 / g1) : 1;
+			static constexpr std::intmax_t g = std::gcd(num, den);
+
+			using type = std::conditional_t<fits, ratio<num / g, den / g>, inexact_ratio<Lhs, Rhs, Multiply>>;
+		};
+
+		template <class Lhs, class Rhs, class = void>
+		struct ratio_product_impl
+		{
+			using type = inexact_ratio<Lhs, Rhs, true>;
+		};
+
 		template <class Lhs, class Rhs>
-		struct ratio_product
+		struct ratio_product_impl<Lhs, Rhs, std::enable_if_t<Lhs::exact && Rhs::exact>>
+		{
+			using type = typename ratio_multiply<Lhs, Rhs, Lhs::num, Lhs::den, Rhs::num, Rhs::den, true>::type;
+		};
+
+		template <class Lhs, class Rhs, class = void>
+		struct ratio_quotient_impl
 		{
-			static constexpr auto factor = Lhs::factor * Rhs::factor;
+			using type = inexact_ratio<Lhs, Rhs, false>;
 		};
 
 		template <class Lhs, class Rhs>
-		struct ratio_quotient
+		struct ratio_quotient_impl<Lhs, Rhs, std::enable_if_t<Lhs::exact && Rhs::exact>>
 		{
-			static constexpr auto factor = Lhs::factor / Rhs::factor;
+			using type = typename ratio_multiply<Lhs, Rhs, Lhs::num, Lhs::den, Rhs::den, Rhs::num, false>::type;
 		};
 
+		// the ratio of composed units, e.g. kilo * kilo * kilo * meters3 is exactly ratio<1000000000, 1>
+		template <class Lhs, class Rhs>
+		using ratio_product = typename ratio_product_impl<Lhs, Rhs>::type;
+
+		template <class Lhs, class Rhs>
+		using ratio_quotient = typename ratio_quotient_impl<Lhs, Rhs>::type;
+
 		template <class T>
 		using promoted_scalar_type = std::conditional_t<std::is_same_v<scalar_value_type_t<T>, SIdouble>, SIdouble, SIdouble>;
 
@@ -742,7 +929,7 @@ namespace SI
 			}
 		};
 
-		template <class Dimension, long N>
+		template <class Dimension, std::intmax_t N>
 		struct unit<Dimension, ratio<N, N>>
 		{
 			template <class T, class = std::enable_if_t<is_arithmetic<T>::value>>
@@ -799,7 +986,7 @@ namespace SI
 		template <class Ratio>
 		struct unit<dimensionless, Ratio> {};
 
-		template <long N>
+		template <std::intmax_t N>
 		struct unit<dimensionless, ratio<N, N>>
 		{
 			template <class T, class = std::enable_if_t<is_arithmetic<T>::value>>
@@ -824,7 +1011,7 @@ namespace SI
 
 	SI_INLINE_CONSTEXPR detail::zero_t zero;
 
-	template <class Dimension, long long numerator = 1, long long denumerator = 1>
+	template <class Dimension, std::intmax_t numerator = 1, std::intmax_t denumerator = 1>
 	using unit = detail::unit<detail::dimension_of_t<Dimension>, detail::ratio<numerator, denumerator>>;
 
 	using detail::abs;
@@ -834,7 +1021,9 @@ namespace SI
 	using detail::pow;
 	using detail::root;
 	using detail::sqrt;
+	using detail::cbrt;
 	using detail::dot;
+	using detail::cross;
 	using detail::clamp;
 	using detail::deangle;
 	using detail::is_si;
@@ -0,0 +1,226 @@
+// <SI/interval.h> - interval arithmetic for rigorous bounds, e.g. formula::braking_distance<interval<SIdouble>>(meters_per_second(interval(27.0, 28.0)), ...)
+//                   (usable as value type of all SI datatypes like vec2/vec3, results always enclose the exact result)
+#pragma once
+#include <SI/conversion.h>
+
+namespace SI
+{
+	namespace internal
+	{
+		// A closed interval [lower, upper] of real numbers. All operations round the bounds outwards by at least
+		// one ulp (instead of switching the FPU rounding mode by fesetround(), which is slow, not usable in constant
+		// expressions, and not honored by optimizing compilers without -frounding-math).
+		template <class T>
+		struct interval
+		{
+			static_assert(std::is_floating_point_v<T>);
+
+			T lower = 0;
+			T upper = 0;
+
+			constexpr interval() = default;
+
+			constexpr interval(T x) : lower(x), upper(x) {} // NOLINT(google-explicit-constructor)
+
+			constexpr interval(T lower, T upper) : lower(lower), upper(upper) {}
+
+			constexpr T midpoint() const { return lower + (upper - lower) / 2; }
+			constexpr T width() const { return upper - lower; }
+			constexpr bool contains(T x) const { return lower <= x && x <= upper; }
+		};
+
+		namespace detail
+		{
+			// rounds down/up by at least one ulp, correct for results rounded to nearest (ulps > 1 for libm functions)
+			template <class T> constexpr T round_down(T x, int ulps = 1)
+			{
+				if (x != x || x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity())
+					return x;
+				return x - ((x < 0 ? -x : x) * std::numeric_limits<T>::epsilon() * ulps + std::numeric_limits<T>::denorm_min());
+			}
+
+			template <class T> constexpr T round_up(T x, int ulps = 1)
+			{
+				return -round_down(-x, ulps);
+			}
+
+			template <class T> constexpr interval<T> outwards(T lower, T upper, int ulps = 1)
+			{
+				return { round_down(lower, ulps), round_up(upper, ulps) };
+			}
+
+			template <class T> constexpr T min4(T a, T b, T c, T d) { return std::min(std::min(a, b), std::min(c, d)); }
+			template <class T> constexpr T max4(T a, T b, T c, T d) { return std::max(std::max(a, b), std::max(c, d)); }
+
+			// encloses a scalar of any arithmetic type (e.g. long double) that might not be exactly representable in T
+			template <class T, class U> constexpr interval<T> enclose(U x)
+			{
+				const T y = static_cast<T>(x);
+				if (static_cast<U>(y) == x)
+					return { y, y };
+				return outwards(y, y);
+			}
+		}
+
+		// unary operators
+		template <class T> [[nodiscard]] constexpr interval<T> operator-(const interval<T>& x) { return { -x.upper, -x.lower }; }
+
+		// comparsion operators (== compares the bounds, < etc. are true if true for all values of the intervals)
+		template <class T> [[nodiscard]] constexpr bool operator==(const interval<T>& lhs, const interval<T>& rhs) { return lhs.lower == rhs.lower && lhs.upper == rhs.upper; }
+		template <class T> [[nodiscard]] constexpr bool operator!=(const interval<T>& lhs, const interval<T>& rhs) { return !(lhs == rhs); }
+		template <class T> [[nodiscard]] constexpr bool operator<(const interval<T>& lhs, const interval<T>& rhs) { return lhs.upper < rhs.lower; }
+		template <class T> [[nodiscard]] constexpr bool operator<=(const interval<T>& lhs, const interval<T>& rhs) { return lhs.upper <= rhs.lower; }
+		template <class T> [[nodiscard]] constexpr bool operator>(const interval<T>& lhs, const interval<T>& rhs) { return rhs < lhs; }
+		template <class T> [[nodiscard]] constexpr bool operator>=(const interval<T>& lhs, const interval<T>& rhs) { return rhs <= lhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator==(const interval<T>& lhs, U rhs) { return lhs == detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator!=(const interval<T>& lhs, U rhs) { return lhs != detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator<(const interval<T>& lhs, U rhs) { return lhs < detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator<=(const interval<T>& lhs, U rhs) { return lhs <= detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator>(const interval<T>& lhs, U rhs) { return lhs > detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr bool operator>=(const interval<T>& lhs, U rhs) { return lhs >= detail::enclose<T>(rhs); }
+
+		// binary operators with other intervals
+		template <class T> [[nodiscard]] constexpr interval<T> operator+(const interval<T>& lhs, const interval<T>& rhs) { return detail::outwards(lhs.lower + rhs.lower, lhs.upper + rhs.upper); }
+		template <class T> [[nodiscard]] constexpr interval<T> operator-(const interval<T>& lhs, const interval<T>& rhs) { return detail::outwards(lhs.lower - rhs.upper, lhs.upper - rhs.lower); }
+
+		template <class T> [[nodiscard]] constexpr interval<T> operator*(const interval<T>& lhs, const interval<T>& rhs)
+		{
+			const T a = lhs.lower * rhs.lower, b = lhs.lower * rhs.upper, c = lhs.upper * rhs.lower, d = lhs.upper * rhs.upper;
+			return detail::outwards(detail::min4(a, b, c, d), detail::max4(a, b, c, d));
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> operator/(const interval<T>& lhs, const interval<T>& rhs)
+		{
+			if (rhs.lower <= 0 && rhs.upper >= 0) // (division by an interval containing zero)
+				return { -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+			const T a = lhs.lower / rhs.lower, b = lhs.lower / rhs.upper, c = lhs.upper / rhs.lower, d = lhs.upper / rhs.upper;
+			return detail::outwards(detail::min4(a, b, c, d), detail::max4(a, b, c, d));
+		}
+
+		// binary operators with scalars
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator+(const interval<T>& lhs, U rhs) { return lhs + detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator-(const interval<T>& lhs, U rhs) { return lhs - detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator*(const interval<T>& lhs, U rhs) { return lhs * detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator/(const interval<T>& lhs, U rhs) { return lhs / detail::enclose<T>(rhs); }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator+(U lhs, const interval<T>& rhs) { return detail::enclose<T>(lhs) + rhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator-(U lhs, const interval<T>& rhs) { return detail::enclose<T>(lhs) - rhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator*(U lhs, const interval<T>& rhs) { return detail::enclose<T>(lhs) * rhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> operator/(U lhs, const interval<T>& rhs) { return detail::enclose<T>(lhs) / rhs; }
+
+		// compound assignment
+		template <class T, class U> constexpr interval<T>& operator+=(interval<T>& lhs, const U& rhs) { return lhs = lhs + rhs; }
+		template <class T, class U> constexpr interval<T>& operator-=(interval<T>& lhs, const U& rhs) { return lhs = lhs - rhs; }
+		template <class T, class U> constexpr interval<T>& operator*=(interval<T>& lhs, const U& rhs) { return lhs = lhs * rhs; }
+		template <class T, class U> constexpr interval<T>& operator/=(interval<T>& lhs, const U& rhs) { return lhs = lhs / rhs; }
+
+		// absolute value, square root, etc. (the bounds of monotonic functions are the function of the bounds)
+		template <class T> [[nodiscard]] constexpr interval<T> abs(const interval<T>& x)
+		{
+			if (x.lower >= 0)
+				return x;
+			if (x.upper <= 0)
+				return -x;
+			return { 0, std::max(-x.lower, x.upper) };
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> sqrt(const interval<T>& x)
+		{
+			if (x.upper < 0)
+				return { std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN() };
+			const interval<T> result = detail::outwards(constexpr_math::sqrt(std::max(x.lower, T(0))), constexpr_math::sqrt(x.upper));
+			return { std::max(result.lower, T(0)), result.upper };
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> cbrt(const interval<T>& x)
+		{
+			return detail::outwards(constexpr_math::cbrt(x.lower), constexpr_math::cbrt(x.upper), 2);
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> exp(const interval<T>& x)
+		{
+			const interval<T> result = detail::outwards(constexpr_math::exp(x.lower), constexpr_math::exp(x.upper), 2);
+			return { std::max(result.lower, T(0)), result.upper };
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> log(const interval<T>& x)
+		{
+			return detail::outwards(constexpr_math::log(x.lower), constexpr_math::log(x.upper), 2);
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> log10(const interval<T>& x)
+		{
+			return detail::outwards(constexpr_math::log10(x.lower), constexpr_math::log10(x.upper), 2);
+		}
+
+		// x raised to the power of y (integer exponents for any x, other exponents for x >= 0)
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr interval<T> pow(const interval<T>& x, U y)
+		{
+			const T a = constexpr_math::pow(x.lower, y), b = constexpr_math::pow(x.upper, y);
+			const bool is_integer = static_cast<U>(static_cast<long long>(y)) == y;
+			if (x.lower >= 0 || (is_integer && x.upper <= 0) || !is_integer)
+				return detail::outwards(std::min(a, b), std::max(a, b), 2); // (monotonic, or NaN for x < 0 and non-integer y)
+			if (y < 0) // (x contains zero)
+				return { -std::numeric_limits<T>::infinity(), std::numeric_limits<T>::infinity() };
+			if (static_cast<long long>(y) % 2 == 0)
+				return { 0, detail::round_up(std::max(a, b), 2) };
+			return detail::outwards(a, b, 2);
+		}
+
+		template <class T> [[nodiscard]] constexpr interval<T> pow(const interval<T>& x, const interval<T>& y)
+		{
+			return exp(y * log(x)); // (for x > 0)
+		}
+
+		// hull of two intervals / intersection of two intervals (empty if lower > upper)
+		template <class T> [[nodiscard]] constexpr interval<T> hull(const interval<T>& a, const interval<T>& b) { return { std::min(a.lower, b.lower), std::max(a.upper, b.upper) }; }
+		template <class T> [[nodiscard]] constexpr interval<T> intersect(const interval<T>& a, const interval<T>& b) { return { std::max(a.lower, b.lower), std::min(a.upper, b.upper) }; }
+
+		// convert intervals into strings, e.g. "[0.50, 0.75]" or "45.30m … 54.92m" (here to be found by ADL of SI::print())
+		template <class T>
+		std::string to_string(const interval<T>& x, const string_format& format = format_of_to_string())
+		{
+			return "[" + SI::to_string(static_cast<SIdouble>(x.lower), format) + ", " + SI::to_string(static_cast<SIdouble>(x.upper), format) + "]";
+		}
+
+		template <class Dimension, class T>
+		std::string to_string(const SI::detail::quantity<Dimension, interval<T>>& x, const string_format& format = format_of_to_string())
+		{
+			return SI::to_string(SI::detail::quantity<Dimension, T>(Dimension(), value(x).lower), format) + " … "
+				+ SI::to_string(SI::detail::quantity<Dimension, T>(Dimension(), value(x).upper), format);
+		}
+	}
+
+	namespace detail
+	{
+		template <class T>
+		using interval = internal::interval<T>;
+
+		template <class T> struct is_arithmetic<internal::interval<T>> : std::true_type {}; // (for units, e.g. meters(interval(1.0, 2.0)))
+		template <class T> struct scalar_value_type<internal::interval<T>> { using type = T; };
+
+		template <class T>
+		constexpr void fill(internal::interval<T>& x, T value)
+		{
+			x = { value, value };
+		}
+	}
+
+	using internal::interval;
+	using internal::hull;
+	using internal::intersect;
+
+	// Returns the lower/upper bound of an interval quantity, e.g. lower(formula::braking_distance<interval<SIdouble>>(...)).
+	template <class Dimension, class T>
+	constexpr auto lower(const detail::quantity<Dimension, interval<T>>& x) { return detail::quantity<Dimension, T>(Dimension(), value(x).lower); }
+
+	template <class Dimension, class T>
+	constexpr auto upper(const detail::quantity<Dimension, interval<T>>& x) { return detail::quantity<Dimension, T>(Dimension(), value(x).upper); }
+
+	template <class T> constexpr T lower(const interval<T>& x) { return x.lower; }
+	template <class T> constexpr T upper(const interval<T>& x) { return x.upper; }
+} // namespace SI
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Interval_arithmetic
+// 2. https://standards.ieee.org/ieee/1788/4431/ (IEEE 1788-2015, interval arithmetic)
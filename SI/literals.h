@@ -117,6 +117,8 @@ LITERAL(_km_per_s, 1e3, meters_per_second); // 1_km_per_s (km/s)
 LITERAL(_m_per_s,  1, meters_per_second);   // 1_m_per_s (m/s)
 LITERAL(_km_per_h, 1, kilometers_per_hour); // 1_km_per_h (km/h)
 LITERAL(_mm_per_h, 1, millimeters_per_hour);// 1_mm_per_h (mm/h)
+// angular speed (ω) in...
+LITERAL(_rad_per_s, 1, radians_per_second); // 1_rad_per_s (rad/s)
 // acceleration (a) in...
 LITERAL(_km_per_s²,1e3, meters_per_second2);// 1_km_per_s² (km/s²)
 LITERAL(_m_per_s², 1, meters_per_second2);  // 1_m_per_s² (m/s²)
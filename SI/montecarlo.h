@@ -0,0 +1,234 @@
+// <SI/montecarlo.h> - Monte Carlo uncertainty propagation, e.g. SI::monte_carlo::propagate({}, formula::kinetic_energy<SIdouble>, normal(2_kg, 10_g), 10_m_per_s).quantile(0.95)
+//                     (with counter-based random numbers in fixed blocks, so the results are the same for any number of threads)
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <SI/batch.h>
+
+namespace SI { namespace monte_carlo {
+
+	// a normal (Gaussian) distribution, e.g. normal(2_kg, 10_g) for 2 kg with a standard uncertainty of 10 g
+	template <class Q>
+	struct normal
+	{
+		Q mean;
+		Q standard_deviation;
+
+		constexpr normal(Q mean, Q standard_deviation) : mean(mean), standard_deviation(standard_deviation) {}
+	};
+
+	// a uniform distribution between lower and upper, e.g. uniform(9_m_per_s, 11_m_per_s)
+	template <class Q>
+	struct uniform
+	{
+		Q lower;
+		Q upper;
+
+		constexpr uniform(Q lower, Q upper) : lower(lower), upper(upper) {}
+	};
+
+	struct options
+	{
+		size_t samples = 100000; // (0 gives an empty result, its statistics are NaN)
+		uint64_t seed = 0;        // (same seed, same results)
+	};
+
+	namespace detail
+	{
+		constexpr size_t block_size = 512; // (samples per block, each block is drawn and evaluated as SoA arrays)
+
+		// the SplitMix64 finalizer, a bijective mixing of 64 bits
+		constexpr uint64_t mix(uint64_t z)
+		{
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+			return z ^ (z >> 31);
+		}
+
+		// the key of an independent random stream
+		constexpr uint64_t key_of(uint64_t seed, uint64_t stream)
+		{
+			return mix(seed ^ mix(stream + 0x9E3779B97F4A7C15u));
+		}
+
+		// Returns random bits for the counter (= sample index) of a stream. Being stateless (counter-based), any
+		// sample can be drawn by any thread in any order with the same result.
+		constexpr uint64_t random_bits(uint64_t key, uint64_t counter)
+		{
+			return mix(key ^ mix(counter));
+		}
+
+		// Returns a uniform random number in (0, 1), never 0 or 1.
+		constexpr SIdouble uniform_of(uint64_t bits)
+		{
+			return (static_cast<SIdouble>(bits >> 11) + 0.5) * 0x1p-53;
+		}
+
+		template <class D> struct quantity_of { using type = D; }; // (constant inputs)
+		template <class Q> struct quantity_of<normal<Q>> { using type = Q; };
+		template <class Q> struct quantity_of<uniform<Q>> { using type = Q; };
+		template <class D> using quantity_of_t = typename quantity_of<D>::type;
+
+		using SI::detail::value; // (for plain dimensionless inputs, quantities are found by ADL)
+
+		template <class Q>
+		constexpr Q from_value(SIdouble x)
+		{
+			if constexpr (std::is_arithmetic_v<Q>)
+				return x;
+			else
+				return Q(typename Q::dimension_type(), x);
+		}
+
+		template <class Q>
+		void draw(const normal<Q>& d, uint64_t stream, uint64_t seed, size_t first, SIdouble* out)
+		{
+			const uint64_t key1 = key_of(seed, 2 * stream), key2 = key_of(seed, 2 * stream + 1);
+			const SIdouble mean = value(d.mean), deviation = value(d.standard_deviation);
+			for (size_t i = 0; i < block_size; i++) // (Box-Muller transform)
+			{
+				const SIdouble u1 = uniform_of(random_bits(key1, first + i)), u2 = uniform_of(random_bits(key2, first + i));
+				out[i] = mean + deviation * std::sqrt(-2 * std::log(u1)) * std::cos(static_cast<SIdouble>(constant::tau) * u2);
+			}
+		}
+
+		template <class Q>
+		void draw(const uniform<Q>& d, uint64_t stream, uint64_t seed, size_t first, SIdouble* out)
+		{
+			const uint64_t key = key_of(seed, 2 * stream);
+			const SIdouble lower = value(d.lower), width = value(d.upper) - value(d.lower);
+			for (size_t i = 0; i < block_size; i++)
+				out[i] = lower + width * uniform_of(random_bits(key, first + i));
+		}
+
+		template <class Q>
+		void draw(const Q& x, uint64_t, uint64_t, size_t, SIdouble* out)
+		{
+			std::fill(out, out + block_size, static_cast<SIdouble>(value(x)));
+		}
+
+		// count, mean and sum of squared deviations of a block (to be merged by Chan's formula)
+		struct moments
+		{
+			SIdouble count = 0, mean = 0, M2 = 0;
+		};
+
+		inline moments merge(const moments& a, const moments& b)
+		{
+			const SIdouble count = a.count + b.count;
+			if (count == 0)
+				return a;
+			const SIdouble delta = b.mean - a.mean;
+			return { count, a.mean + delta * (b.count / count), a.M2 + b.M2 + delta * delta * (a.count * b.count / count) };
+		}
+	}
+
+	// the resulting distribution of a Monte Carlo propagation
+	template <class Q>
+	class result
+	{
+	public:
+		result(std::vector<SIdouble>&& samples, const std::vector<detail::moments>& blocks)
+			: m_samples(std::move(samples))
+		{
+			for (const auto& block : blocks) // (always in block order, for bit-identical results)
+				m_moments = detail::merge(m_moments, block);
+			std::sort(m_samples.begin(), m_samples.end());
+		}
+
+		size_t samples() const { return m_samples.size(); }
+		Q mean() const { return detail::from_value<Q>(m_samples.empty() ? nan : m_moments.mean); }
+		auto variance() const { return detail::from_value<decltype(Q() * Q())>(sample_variance()); }
+		Q standard_deviation() const { return detail::from_value<Q>(std::sqrt(sample_variance())); }
+		Q minimum() const { return detail::from_value<Q>(m_samples.empty() ? nan : m_samples.front()); }
+		Q maximum() const { return detail::from_value<Q>(m_samples.empty() ? nan : m_samples.back()); }
+
+		// Returns the quantile for probability (p) in [0, 1], e.g. 0.5 for the median (linear between order statistics).
+		Q quantile(dimensionless p) const
+		{
+			assert(p >= 0 && p <= 1);
+			if (m_samples.empty())
+				return detail::from_value<Q>(nan); // (no samples, and size() - 1 below would wrap around)
+			const SIdouble h = (m_samples.size() - 1) * p;
+			const size_t i = std::min(static_cast<size_t>(h), m_samples.size() - 1), j = std::min(i + 1, m_samples.size() - 1);
+			return detail::from_value<Q>(m_samples[i] + (h - i) * (m_samples[j] - m_samples[i]));
+		}
+
+	private:
+		static constexpr SIdouble nan = std::numeric_limits<SIdouble>::quiet_NaN(); // (the statistics of no samples)
+
+		std::vector<SIdouble> m_samples; // (sorted)
+		detail::moments m_moments;
+
+		SIdouble sample_variance() const { return m_samples.empty() ? nan : m_moments.M2 / std::max<SIdouble>(1, m_moments.count - 1); }
+	};
+
+	namespace detail
+	{
+		template <class Function, class... Inputs, size_t... Index>
+		auto propagate(const parallel_t* policy, const options& opts, Function& function, std::index_sequence<Index...>, const Inputs&... inputs)
+		{
+			using Q = std::decay_t<std::invoke_result_t<Function&, quantity_of_t<Inputs>...>>;
+			SI_CHECK_FP("monte_carlo::propagate", quantity_of_t<Inputs>...);
+
+			const size_t blocks = (opts.samples + block_size - 1) / block_size;
+			std::vector<SIdouble> samples(opts.samples);
+			std::vector<moments> block_moments(blocks);
+			auto loop = [&](size_t begin, size_t end)
+			{
+				std::array<std::array<SIdouble, block_size>, sizeof...(Inputs)> in; // (SoA, one array per input)
+				std::array<SIdouble, block_size> out;
+				for (size_t block = begin; block < end; block++)
+				{
+					const size_t first = block * block_size, count = std::min(block_size, opts.samples - first);
+					(draw(inputs, Index, opts.seed, first, in[Index].data()), ...);
+					for (size_t i = 0; i < count; i++)
+						out[i] = static_cast<SIdouble>(value(function(from_value<quantity_of_t<Inputs>>(in[Index][i])...)));
+					moments m = { static_cast<SIdouble>(count), 0, 0 };
+					for (size_t i = 0; i < count; i++)
+						m.mean += out[i];
+					m.mean /= m.count;
+					for (size_t i = 0; i < count; i++)
+						m.M2 += (out[i] - m.mean) * (out[i] - m.mean);
+					block_moments[block] = m;
+					std::copy(out.begin(), out.begin() + count, samples.begin() + first);
+				}
+			};
+			if (policy != nullptr)
+				SI::detail::parallel_for({ std::max<size_t>(1, policy->min_batch / block_size) }, blocks, loop);
+			else
+				loop(0, blocks);
+			return result<Q>(std::move(samples), block_moments);
+		}
+	}
+
+	// Propagates the uncertainties of the inputs (distributions or constants) through the function by random sampling,
+	// e.g. propagate({}, formula::kinetic_energy<SIdouble>, normal(2_kg, 10_g), uniform(9_m_per_s, 11_m_per_s)).mean()
+	template <class Function, class... Inputs>
+	auto propagate(const options& opts, Function&& function, const Inputs&... inputs)
+	{
+		return detail::propagate(nullptr, opts, function, std::index_sequence_for<Inputs...>(), inputs...);
+	}
+
+	// Propagates the uncertainties of the inputs through the function by random sampling, multithreaded
+	// (with the same results as single-threaded).
+	template <class Function, class... Inputs>
+	auto propagate(const parallel_t& policy, const options& opts, Function&& function, const Inputs&... inputs)
+	{
+		return detail::propagate(&policy, opts, function, std::index_sequence_for<Inputs...>(), inputs...);
+	}
+
+} } // namespace SI::monte_carlo
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Monte_Carlo_method
+// 2. https://www.thesalmons.org/john/random123/papers/random123sc11.pdf (counter-based random number generators)
+// 3. https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
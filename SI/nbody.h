@@ -0,0 +1,352 @@
+// <SI/nbody.h> - gravitational N-body simulations, e.g. SI::nbody::simulation(bodies).step(1_h)
+//                (direct summation for few bodies, Barnes-Hut octree for many, symplectic leapfrog integration)
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <SI/batch.h>
+
+namespace SI { namespace nbody {
+
+	struct body
+	{
+		SI::mass mass;
+		length3 position;
+		velocity3 velocity;
+	};
+
+	struct options
+	{
+		length softening = 0_m;            // (Plummer softening, avoids singularities at close encounters)
+		dimensionless opening_angle = 0.5; // (Barnes-Hut θ, smaller is more exact)
+		size_t direct_limit = 1024;        // (direct summation up to this number of bodies, Barnes-Hut above)
+	};
+
+	namespace detail
+	{
+		// positions and G·m of all bodies as SoA arrays
+		struct points
+		{
+			std::vector<SIdouble> x, y, z, Gm;
+		};
+
+		points points_of(span<const body> bodies)
+		{
+			points p;
+			for (auto* a : { &p.x, &p.y, &p.z, &p.Gm })
+				a->resize(bodies.size());
+			for (size_t i = 0; i < bodies.size(); i++)
+			{
+				const auto& position = value(bodies[i].position);
+				p.x[i] = position.x, p.y[i] = position.y, p.z[i] = position.z;
+				p.Gm[i] = value(constant::G * bodies[i].mass);
+			}
+			return p;
+		}
+
+		// Sums the accelerations of bodies [begin, end) by all bodies, the inner loop is vectorized by the compiler.
+		void direct(const points& p, size_t begin, size_t end, SIdouble eps2, acceleration3* out)
+		{
+			const size_t count = p.x.size();
+			const SIdouble* x = p.x.data();
+			const SIdouble* y = p.y.data();
+			const SIdouble* z = p.z.data();
+			const SIdouble* Gm = p.Gm.data();
+			for (size_t i = begin; i < end; i++)
+			{
+				SIdouble ax = 0, ay = 0, az = 0;
+				for (size_t j = 0; j < count; j++)
+				{
+					const SIdouble dx = x[j] - x[i], dy = y[j] - y[i], dz = z[j] - z[i];
+					const SIdouble r2 = dx * dx + dy * dy + dz * dz;
+					const SIdouble r2_soft = r2 + eps2;
+					const SIdouble s = r2 > 0 ? Gm[j] / (r2_soft * std::sqrt(r2_soft)) : 0; // (skips the body itself)
+					ax += s * dx, ay += s * dy, az += s * dz;
+				}
+				out[i] = meters_per_second2(ax, ay, az);
+			}
+		}
+
+		// a node of the Barnes-Hut octree, stored in a flat array in depth-first order
+		struct node
+		{
+			SIdouble Gm, x, y, z; // (total G·m and center of mass)
+			SIdouble size;        // (edge length of the cube)
+			uint32_t first, count; // (the bodies in the node, as range of the index array)
+			int32_t children[8];
+		};
+
+		struct octree
+		{
+			std::vector<node> nodes;
+			std::vector<uint32_t> indices; // (sorted by Morton code, so each node holds a range of them)
+		};
+
+		constexpr int morton_bits = 21; // (per axis, so a code fits into 63 bits and coincident bodies end up together in leaves)
+
+		// Returns the lower 21 bits of v with two zero bits inserted after each (to interleave three of them).
+		constexpr uint64_t spread_bits(uint64_t v)
+		{
+			v &= 0x1fffff;
+			v = (v | v << 32) & 0x1f00000000ffff;
+			v = (v | v << 16) & 0x1f0000ff0000ff;
+			v = (v | v << 8) & 0x100f00f00f00f00f;
+			v = (v | v << 4) & 0x10c30c30c30c30c3;
+			v = (v | v << 2) & 0x1249249249249249;
+			return v;
+		}
+
+		// Builds the node of the sorted bodies [first, first + count), all having the same top 3 * depth bits of their codes.
+		int32_t build(octree& tree, const points& p, const std::vector<uint64_t>& codes, uint32_t first, uint32_t count, SIdouble cx, SIdouble cy, SIdouble cz, SIdouble half, int depth)
+		{
+			const int32_t index = static_cast<int32_t>(tree.nodes.size());
+			tree.nodes.push_back({ 0, 0, 0, 0, 2 * half, first, count, { -1, -1, -1, -1, -1, -1, -1, -1 } });
+			SIdouble Gm = 0, x = 0, y = 0, z = 0;
+			if (count <= 1 || depth >= morton_bits)
+			{
+				for (uint32_t k = first; k < first + count; k++)
+				{
+					const uint32_t i = tree.indices[k];
+					Gm += p.Gm[i], x += p.Gm[i] * p.x[i], y += p.Gm[i] * p.y[i], z += p.Gm[i] * p.z[i];
+				}
+			}
+			else
+			{
+				const int shift = 3 * (morton_bits - 1 - depth);
+				const SIdouble q = half / 2;
+				for (uint32_t k = first, end = first + count; k < end; )
+				{
+					const int o = static_cast<int>((codes[k] >> shift) & 7); // (the octants of the range are ascending)
+					const uint32_t next = static_cast<uint32_t>(std::partition_point(codes.begin() + k, codes.begin() + end,
+						[&](uint64_t code) { return static_cast<int>((code >> shift) & 7) == o; }) - codes.begin());
+					const int32_t child = build(tree, p, codes, k, next - k, cx + (o & 1 ? q : -q), cy + (o & 2 ? q : -q), cz + (o & 4 ? q : -q), q, depth + 1);
+					tree.nodes[index].children[o] = child;
+					const node& c = tree.nodes[child];
+					Gm += c.Gm, x += c.Gm * c.x, y += c.Gm * c.y, z += c.Gm * c.z;
+					k = next;
+				}
+			}
+			node& n = tree.nodes[index];
+			n.Gm = Gm;
+			if (Gm > 0)
+				n.x = x / Gm, n.y = y / Gm, n.z = z / Gm;
+			return index;
+		}
+
+		// Builds the octree from the bodies sorted by the Morton codes of their positions (calculated multithreaded if a
+		// policy is given), so the nodes are ranges of one index array and no node allocates.
+		template <class Policy>
+		octree octree_of(const Policy* policy, const points& p)
+		{
+			octree tree;
+			const size_t count = p.x.size();
+			SIdouble min[3] = { p.x[0], p.y[0], p.z[0] }, max[3] = { p.x[0], p.y[0], p.z[0] };
+			for (uint32_t i = 0; i < count; i++)
+			{
+				min[0] = std::min(min[0], p.x[i]), min[1] = std::min(min[1], p.y[i]), min[2] = std::min(min[2], p.z[i]);
+				max[0] = std::max(max[0], p.x[i]), max[1] = std::max(max[1], p.y[i]), max[2] = std::max(max[2], p.z[i]);
+			}
+			const SIdouble half = 0.5 * std::max({ max[0] - min[0], max[1] - min[1], max[2] - min[2], 1e-9 }) * 1.0001;
+			const SIdouble center[3] = { 0.5 * (min[0] + max[0]), 0.5 * (min[1] + max[1]), 0.5 * (min[2] + max[2]) };
+
+			const SIdouble cells = SIdouble(1 << morton_bits), per_cell = cells / (2 * half);
+			auto cell_of = [&](SIdouble coordinate, int axis) { return static_cast<uint64_t>(std::min(std::max((coordinate - center[axis] + half) * per_cell, 0.0), cells - 1)); };
+			std::vector<std::pair<uint64_t, uint32_t>> keys(count);
+			auto loop = [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					keys[i] = { spread_bits(cell_of(p.x[i], 0)) | spread_bits(cell_of(p.y[i], 1)) << 1 | spread_bits(cell_of(p.z[i], 2)) << 2, static_cast<uint32_t>(i) };
+			};
+			if (policy != nullptr)
+				SI::detail::parallel_for(*policy, count, loop);
+			else
+				loop(0, count);
+			std::sort(keys.begin(), keys.end());
+
+			std::vector<uint64_t> codes(count);
+			tree.indices.resize(count);
+			for (size_t k = 0; k < count; k++)
+				codes[k] = keys[k].first, tree.indices[k] = keys[k].second;
+			tree.nodes.reserve(2 * count);
+			build(tree, p, codes, 0, static_cast<uint32_t>(count), center[0], center[1], center[2], half, 0);
+			return tree;
+		}
+
+		// Sums the accelerations of the bodies [begin, end) of the Morton order by walking the octree. Nodes containing
+		// the body are always opened, else it would attract itself through their center of mass.
+		void Barnes_Hut(const points& p, const octree& tree, size_t begin, size_t end, SIdouble eps2, SIdouble theta, acceleration3* out)
+		{
+			std::vector<int32_t> stack;
+			stack.reserve(8 * morton_bits);
+			for (size_t k = begin; k < end; k++)
+			{
+				const uint32_t i = tree.indices[k];
+				const SIdouble xi = p.x[i], yi = p.y[i], zi = p.z[i];
+				SIdouble ax = 0, ay = 0, az = 0;
+				stack.assign(1, 0);
+				while (!stack.empty())
+				{
+					const node& n = tree.nodes[stack.back()];
+					stack.pop_back();
+					const SIdouble dx = n.x - xi, dy = n.y - yi, dz = n.z - zi;
+					const SIdouble r2 = dx * dx + dy * dy + dz * dz;
+					const bool is_leaf = n.count <= 1 || (n.children[0] < 0 && n.children[1] < 0 && n.children[2] < 0 && n.children[3] < 0
+						&& n.children[4] < 0 && n.children[5] < 0 && n.children[6] < 0 && n.children[7] < 0);
+					const bool contains_body = n.first <= k && k < n.first + n.count;
+					if (is_leaf)
+					{
+						for (uint32_t l = n.first; l < n.first + n.count; l++)
+						{
+							const uint32_t j = tree.indices[l];
+							const SIdouble ex = p.x[j] - xi, ey = p.y[j] - yi, ez = p.z[j] - zi;
+							const SIdouble e2 = ex * ex + ey * ey + ez * ez;
+							if (e2 == 0)
+								continue; // (the body itself)
+							const SIdouble s = p.Gm[j] / ((e2 + eps2) * std::sqrt(e2 + eps2));
+							ax += s * ex, ay += s * ey, az += s * ez;
+						}
+					}
+					else if (!contains_body && n.size * n.size < theta * theta * r2) // (far enough away, use the center of mass)
+					{
+						const SIdouble s = n.Gm / ((r2 + eps2) * std::sqrt(r2 + eps2));
+						ax += s * dx, ay += s * dy, az += s * dz;
+					}
+					else
+					{
+						for (int32_t child : n.children)
+							if (child >= 0)
+								stack.push_back(child);
+					}
+				}
+				out[i] = meters_per_second2(ax, ay, az);
+			}
+		}
+
+		template <class Policy>
+		void accelerations(const Policy* policy, span<const body> bodies, span<acceleration3> out, const options& opts)
+		{
+			assert(out.size() >= bodies.size());
+			if (bodies.empty())
+				return;
+			const points p = points_of(bodies);
+			const SIdouble eps2 = value(square(opts.softening));
+			if (bodies.size() <= opts.direct_limit)
+			{
+				auto loop = [&](size_t begin, size_t end) { direct(p, begin, end, eps2, out.data()); };
+				if (policy != nullptr)
+					SI::detail::parallel_for(*policy, bodies.size(), loop);
+				else
+					loop(0, bodies.size());
+				return;
+			}
+			const octree tree = octree_of(policy, p);
+			auto loop = [&](size_t begin, size_t end) { Barnes_Hut(p, tree, begin, end, eps2, opts.opening_angle, out.data()); };
+			if (policy != nullptr)
+				SI::detail::parallel_for(*policy, bodies.size(), loop);
+			else
+				loop(0, bodies.size());
+		}
+	}
+
+	// Calculates the gravitational accelerations of all bodies (direct summation or Barnes-Hut, see options).
+	void accelerations(span<const body> bodies, span<acceleration3> out, const options& opts = {})
+	{
+		detail::accelerations<parallel_t>(nullptr, bodies, out, opts);
+	}
+
+	// Calculates the gravitational accelerations of all bodies, multithreaded.
+	void accelerations(const parallel_t& policy, span<const body> bodies, span<acceleration3> out, const options& opts = {})
+	{
+		detail::accelerations(&policy, bodies, out, opts);
+	}
+
+	// Calculates the total energy (kinetic + potential) of all bodies by direct summation (O(n²), single-threaded).
+	energy total_energy(span<const body> bodies, const options& opts = {})
+	{
+		const SIdouble eps2 = value(square(opts.softening));
+		energy kinetic = 0_J, potential = 0_J;
+		for (size_t i = 0; i < bodies.size(); i++)
+		{
+			kinetic += 0.5 * bodies[i].mass * dot(bodies[i].velocity, bodies[i].velocity);
+			SIdouble sum = 0; // (G·m_j / r_ij for j > i)
+			const auto& a = value(bodies[i].position);
+			for (size_t j = i + 1; j < bodies.size(); j++)
+			{
+				const auto& b = value(bodies[j].position);
+				const SIdouble dx = b.x - a.x, dy = b.y - a.y, dz = b.z - a.z;
+				sum += value(constant::G * bodies[j].mass) / std::sqrt(dx * dx + dy * dy + dz * dz + eps2);
+			}
+			potential -= joules(value(bodies[i].mass) * sum);
+		}
+		return kinetic + potential;
+	}
+
+	// A simulation of bodies by symplectic leapfrog integration (kick-drift-kick), keeping track of the energy drift.
+	class simulation
+	{
+	public:
+		explicit simulation(std::vector<body> bodies, const options& opts = {})
+			: m_bodies(std::move(bodies)), m_accelerations(m_bodies.size()), m_options(opts), m_initial_bodies(m_bodies)
+		{
+			accelerations(m_bodies, m_accelerations, m_options);
+		}
+
+		// Advances the simulation by time step (dt).
+		void step(SI::time dt)
+		{
+			step<parallel_t>(nullptr, dt);
+		}
+
+		// Advances the simulation by time step (dt), multithreaded.
+		void step(const parallel_t& policy, SI::time dt)
+		{
+			step(&policy, dt);
+		}
+
+		const std::vector<body>& bodies() const { return m_bodies; }
+		SI::time elapsed() const { return m_elapsed; }
+		energy total_energy() const { return nbody::total_energy(m_bodies, m_options); } // (O(n²), see above)
+
+		// Returns the total energy now minus at the start (ideally zero, grows with the time step). O(n²) as total_energy(),
+		// twice on the first call: the initial energy is only calculated then, from a copy of the initial bodies.
+		energy energy_drift() const
+		{
+			if (!m_initial_bodies.empty())
+			{
+				m_initial_energy = nbody::total_energy(m_initial_bodies, m_options);
+				std::vector<body>().swap(m_initial_bodies); // (frees the copy)
+			}
+			return total_energy() - m_initial_energy;
+		}
+
+	private:
+		std::vector<body> m_bodies;
+		std::vector<acceleration3> m_accelerations;
+		options m_options;
+		mutable std::vector<body> m_initial_bodies; // (until energy_drift() needs them)
+		mutable energy m_initial_energy = 0_J;
+		SI::time m_elapsed = 0_s;
+
+		template <class Policy>
+		void step(const Policy* policy, SI::time dt)
+		{
+			for (size_t i = 0; i < m_bodies.size(); i++)
+			{
+				m_bodies[i].velocity += (0.5 * dt) * m_accelerations[i];
+				m_bodies[i].position += dt * m_bodies[i].velocity;
+			}
+			detail::accelerations(policy, m_bodies, m_accelerations, m_options);
+			for (size_t i = 0; i < m_bodies.size(); i++)
+				m_bodies[i].velocity += (0.5 * dt) * m_accelerations[i];
+			m_elapsed += dt;
+		}
+	};
+
+} } // namespace SI::nbody
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/N-body_simulation
+// 2. https://en.wikipedia.org/wiki/Barnes%E2%80%93Hut_simulation
+// 3. https://en.wikipedia.org/wiki/Leapfrog_integration
+// 4. https://en.wikipedia.org/wiki/Z-order_curve (Morton codes)
@@ -0,0 +1,182 @@
+// <SI/orbits.h> - elliptic orbits by Kepler's equation, e.g. SI::orbit::state_at(elements, 100_days).position
+//                 (positions and velocities are relative to the central body, in its reference frame)
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <SI/batch.h>
+
+namespace SI { namespace orbit {
+
+	// the Keplerian elements of an elliptic orbit (eccentricity < 1)
+	struct elements
+	{
+		length semimajor_axis;
+		dimensionless eccentricity = 0;
+		SI::time period;
+		angle mean_anomaly_at_epoch = 0; // (at time 0)
+		angle inclination = 0;
+		angle longitude_of_ascending_node = 0;
+		angle argument_of_periapsis = 0;
+	};
+
+	// the position and velocity of an orbiting body
+	struct state
+	{
+		length3 position;
+		velocity3 velocity;
+	};
+
+	// Calculates the orbital period from semi-major axis (a) and the standard gravitational parameter (GM) of the central body.
+	constexpr SI::time period_of(length a, volume_per_time_squared GM)
+	{
+		return constant::tau * sqrt(cube(a) / GM);
+	}
+
+	namespace detail
+	{
+		constexpr int Kepler_iterations = 4; // (residuals |E - e·sin(E) - M| below 1e-15 up to e = 0.99999, see example 62)
+
+		// Solves Kepler's equation M = E - e·sin(E) by Halley's method with a fixed number of iterations
+		// (without data-dependent branches, so each element of a batch takes the same time).
+		SIdouble eccentric_anomaly(SIdouble M, SIdouble e)
+		{
+			M -= constant::tau * std::floor(M / constant::tau + 0.5); // (to [-π, π])
+			// (near the periapsis of eccentric orbits, start from the root of the cubic M = (1 - e)·E + e·E³/6, else Danby's value)
+			const SIdouble e_cubic = std::max(e, 0.5); // (so unused starting values raise no floating-point exceptions)
+			const SIdouble p = 6 * (1 - e_cubic) / e_cubic, q = 6 * std::fabs(M) / e_cubic; // (E³ + p·E = q)
+			const SIdouble w = std::cbrt(0.5 * q + std::sqrt(0.25 * q * q + p * p * p / 27));
+			const SIdouble cubic_start = std::copysign(q / (w * w + p / 3 + p * p / (9 * w * w)), M); // (Cardano's root without cancellation)
+			SIdouble E = (e > 0.5 && std::fabs(M) < 1) ? cubic_start : M + (M < 0 ? -0.85 : 0.85) * e;
+			for (int i = 0; i < Kepler_iterations; i++)
+			{
+				const SIdouble e_sin_E = e * std::sin(E), e_cos_E = e * std::cos(E);
+				const SIdouble f = E - e_sin_E - M, df = 1 - e_cos_E;
+				E -= f / (df - 0.5 * f * e_sin_E / df);
+			}
+			return E;
+		}
+
+		// the perifocal frame (P towards the periapsis, Q 90° ahead in the orbital plane) in the reference frame
+		struct orientation
+		{
+			SI::detail::vec3<SIdouble> P, Q;
+		};
+
+		orientation orientation_of(const elements& o)
+		{
+			const SIdouble O = static_cast<SIdouble>(o.longitude_of_ascending_node), w = static_cast<SIdouble>(o.argument_of_periapsis), i = static_cast<SIdouble>(o.inclination);
+			const SIdouble cos_O = std::cos(O), sin_O = std::sin(O), cos_w = std::cos(w), sin_w = std::sin(w), cos_i = std::cos(i), sin_i = std::sin(i);
+			return {
+				{ cos_O * cos_w - sin_O * sin_w * cos_i, sin_O * cos_w + cos_O * sin_w * cos_i, sin_w * sin_i },
+				{ -cos_O * sin_w - sin_O * cos_w * cos_i, -sin_O * sin_w + cos_O * cos_w * cos_i, cos_w * sin_i },
+			};
+		}
+
+		state state_at(const elements& o, const orientation& frame, SI::time t)
+		{
+			const SIdouble a = value(o.semimajor_axis), e = o.eccentricity;
+			const SIdouble n = value(constant::tau / o.period); // (mean motion)
+			const SIdouble E = eccentric_anomaly(static_cast<SIdouble>(o.mean_anomaly_at_epoch) + n * value(t), e);
+			const SIdouble cos_E = std::cos(E), sin_E = std::sin(E), b = a * std::sqrt(1 - e * e);
+			const SIdouble E_rate = n / (1 - e * cos_E);
+			const SIdouble x = a * (cos_E - e), y = b * sin_E;                 // (in the orbital plane)
+			const SIdouble vx = -a * sin_E * E_rate, vy = b * cos_E * E_rate;
+			return {
+				meters(x * frame.P.x + y * frame.Q.x, x * frame.P.y + y * frame.Q.y, x * frame.P.z + y * frame.Q.z),
+				meters_per_second(vx * frame.P.x + vy * frame.Q.x, vx * frame.P.y + vy * frame.Q.y, vx * frame.P.z + vy * frame.Q.z),
+			};
+		}
+	}
+
+	// Calculates the mean anomaly of the orbit at time (t).
+	angle mean_anomaly(const elements& o, SI::time t)
+	{
+		return o.mean_anomaly_at_epoch + constant::tau * (t / o.period);
+	}
+
+	// Solves Kepler's equation for the eccentric anomaly (E) from mean anomaly (M) and eccentricity (e).
+	angle eccentric_anomaly(angle M, dimensionless e)
+	{
+		return detail::eccentric_anomaly(static_cast<SIdouble>(M), e);
+	}
+
+	// Solves Kepler's equation for many mean anomalies (M, in radians) and eccentricities (e) on SoA arrays.
+	void eccentric_anomaly(span<const dimensionless> M, span<const dimensionless> e, span<dimensionless> E)
+	{
+		assert(e.size() >= M.size() && E.size() >= M.size());
+		const SIdouble* m = M.data();
+		const SIdouble* ecc = e.data();
+		SIdouble* out = E.data();
+		for (size_t i = 0; i < M.size(); i++)
+			out[i] = detail::eccentric_anomaly(m[i], ecc[i]);
+	}
+
+	// Calculates the true anomaly from eccentric anomaly (E) and eccentricity (e).
+	angle true_anomaly(angle E, dimensionless e)
+	{
+		return 2 * std::atan2(std::sqrt(1 + e) * std::sin(E / 2), std::sqrt(1 - e) * std::cos(E / 2));
+	}
+
+	// Calculates the position and velocity on the orbit at time (t).
+	state state_at(const elements& o, SI::time t)
+	{
+		return detail::state_at(o, detail::orientation_of(o), t);
+	}
+
+	// Calculates the positions and velocities of many orbits at time (t).
+	void state_at(span<const elements> orbits, SI::time t, span<state> states)
+	{
+		assert(states.size() >= orbits.size());
+		for (size_t i = 0; i < orbits.size(); i++)
+			states[i] = state_at(orbits[i], t);
+	}
+
+	// Calculates the positions and velocities of many orbits at time (t), multithreaded for very large batches.
+	void state_at(const parallel_t& policy, span<const elements> orbits, SI::time t, span<state> states)
+	{
+		assert(states.size() >= orbits.size());
+		SI::detail::parallel_for(policy, orbits.size(), [&](size_t begin, size_t end)
+		{
+			state_at(orbits.subspan(begin, end - begin), t, states.subspan(begin, end - begin));
+		});
+	}
+
+	// Returns the elements of a record of a dataset with orbit_semimajor_axis, eccentricity and orbital_period (e.g. of
+	// dataset::exoplanets), or false if there's no elliptic orbit: if the semi-major axis or the period is unknown (0 or
+	// NaN) or the eccentricity is 1 or more. An unknown eccentricity (NaN) is taken as 0, i.e. a circular orbit.
+	template <class Record>
+	bool elements_of(const Record& r, elements& result)
+	{
+		const SIdouble a = value(r.orbit_semimajor_axis), T = value(r.orbital_period), e = r.eccentricity;
+		if (!(a > 0) || !(T > 0) || e >= 1 || e < 0)
+			return false;
+		result = { r.orbit_semimajor_axis, std::isnan(e) ? 0 : e, r.orbital_period };
+		return true;
+	}
+
+	// Calculates the positions and velocities on the orbit at many epochs.
+	void state_at(const elements& o, span<const SI::time> epochs, span<state> states)
+	{
+		assert(states.size() >= epochs.size());
+		const auto frame = detail::orientation_of(o);
+		for (size_t i = 0; i < epochs.size(); i++)
+			states[i] = detail::state_at(o, frame, epochs[i]);
+	}
+
+	// Calculates the positions and velocities on the orbit at many epochs, multithreaded for very large batches.
+	void state_at(const parallel_t& policy, const elements& o, span<const SI::time> epochs, span<state> states)
+	{
+		assert(states.size() >= epochs.size());
+		SI::detail::parallel_for(policy, epochs.size(), [&](size_t begin, size_t end)
+		{
+			state_at(o, epochs.subspan(begin, end - begin), states.subspan(begin, end - begin));
+		});
+	}
+
+} } // namespace SI::orbit
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Kepler%27s_equation
+// 2. https://en.wikipedia.org/wiki/Orbital_elements
+// 3. https://en.wikipedia.org/wiki/Perifocal_coordinate_system
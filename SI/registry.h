@@ -0,0 +1,410 @@
+// <SI/registry.h> - runtime registry of unit symbols, e.g. parse_unit("kg*m/s^2", unit) or from_unit(12.0, "km/h", speed)
+//                   (the registry is built at compile-time from the literals, lookups use a perfect hash)
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <SI/instrumentation.h>
+#include <SI/literals.h>
+
+namespace SI
+{
+	// a unit known at runtime only: SI value = (value * factor) + offset
+	struct runtime_unit
+	{
+		std::array<signed char, 7> dimension; // the exponents for length, mass, time, temperature, current, substance, intensity
+		SIdouble factor;
+		SIdouble offset;
+	};
+
+	namespace detail
+	{
+		template <class Dimension>
+		constexpr std::array<signed char, 7> exponents_of()
+		{
+			return { static_cast<signed char>(Dimension::length), static_cast<signed char>(Dimension::mass),
+				static_cast<signed char>(Dimension::time), static_cast<signed char>(Dimension::temperature),
+				static_cast<signed char>(Dimension::current), static_cast<signed char>(Dimension::substance),
+				static_cast<signed char>(Dimension::intensity) };
+		}
+
+		struct registered_unit
+		{
+			std::string_view symbol;
+			runtime_unit unit;
+		};
+
+		template <class T>
+		constexpr registered_unit register_unit(std::string_view symbol, const T& one)
+		{
+			return { symbol, { exponents_of<dimension_of_t<T>>(), static_cast<SIdouble>(value(one)), 0.0 } };
+		}
+
+#define REGISTER(_symbol, _literal) register_unit(_symbol, operator "" _literal(1.0L))
+
+		//               SYMBOL       LITERAL
+		constexpr registered_unit registered_units[] = {
+			// length in...
+			REGISTER("Gm",       _Gm),  REGISTER("Mm",  _Mm),  REGISTER("km",  _km),  REGISTER("m",   _m),
+			REGISTER("dm",       _dm),  REGISTER("cm",  _cm),  REGISTER("mm",  _mm),  REGISTER("um",  _um),
+			REGISTER("μm",       _um),  REGISTER("nm",  _nm),  REGISTER("pm",  _pm),  REGISTER("Ang", _Ang),
+			REGISTER("au",       _au),  REGISTER("AU",  _AU),  REGISTER("ly",  _ly),  REGISTER("pc",  _pc),
+			REGISTER("kpc",      _kpc), REGISTER("Mpc", _Mpc), REGISTER("Gpc", _Gpc),
+			REGISTER("in",       _in),  REGISTER("ft",  _ft),  REGISTER("yd",  _yd),  REGISTER("mi",  _mi),
+			REGISTER("nmi",      _nmi), REGISTER("NM",  _NM),
+			// time in...
+			REGISTER("day",      _day), REGISTER("days", _days), REGISTER("h",  _h), REGISTER("hrs", _h),
+			REGISTER("min",      _min), REGISTER("s",   _s),   REGISTER("sec", _s),   REGISTER("seconds", _s),
+			REGISTER("ms",       _ms),  REGISTER("us",  _us),  REGISTER("μs",  _us),  REGISTER("ns",  _ns),
+			REGISTER("ps",       _ps),
+			// mass in...
+			REGISTER("Gt",       _Gt),  REGISTER("Mt",  _Mt),  REGISTER("kt",  _kt),  REGISTER("t",   _t),
+			REGISTER("kg",       _kg),  REGISTER("g",   _g),   REGISTER("mg",  _mg),  REGISTER("ug",  _ug),
+			REGISTER("µg",       _ug),  REGISTER("ng",  _ng),  REGISTER("Da",  _Da),  REGISTER("oz",  _oz),
+			REGISTER("lb",       _lb),
+			// temperature in... (see below for °C and °F)
+			REGISTER("GK",       _GK),  REGISTER("MK",  _MK),  REGISTER("kK",  _kK),  REGISTER("K",   _K),
+			REGISTER("mK",       _mK),  REGISTER("uK",  _uK),  REGISTER("nK",  _nK),  REGISTER("°R",  _degR),
+			REGISTER("degR",     _degR),
+			// electric current in...
+			REGISTER("GA",       _GA),  REGISTER("MA",  _MA),  REGISTER("kA",  _kA),  REGISTER("A",   _A),
+			REGISTER("mA",       _mA),  REGISTER("uA",  _uA),  REGISTER("nA",  _nA),  REGISTER("pA",  _pA),
+			// amount of substance and luminous intensity in...
+			REGISTER("kmol",     _kmol), REGISTER("mol", _mol), REGISTER("mmol", _mmol), REGISTER("umol", _umol),
+			REGISTER("kcd",      _kcd), REGISTER("cd",  _cd),
+			// area and volume in...
+			REGISTER("km²",      _km²), REGISTER("hm²", _hm²), REGISTER("m²",  _m²),  REGISTER("cm²", _cm²),
+			REGISTER("mm²",      _mm²), REGISTER("km³", _km³), REGISTER("m³",  _m³),  REGISTER("dm³", _dm³),
+			REGISTER("cm³",      _cm³), REGISTER("mm³", _mm³), REGISTER("hl",  _hl),  REGISTER("l",   _l),
+			REGISTER("ml",       _ml),  REGISTER("ul",  _ul),  REGISTER("gal", _gal),
+			// velocity and acceleration in...
+			REGISTER("km/s",     _km_per_s), REGISTER("m/s", _m_per_s), REGISTER("km/h", _km_per_h), REGISTER("mm/h", _mm_per_h),
+			REGISTER("kn",       _kn),  REGISTER("mph", _mph), REGISTER("ft/min", _ft_per_min), REGISTER("Mach", _Mach),
+			REGISTER("km/s²",    _km_per_s²), REGISTER("m/s²", _m_per_s²),
+			// frequency in...
+			REGISTER("THz",      _THz), REGISTER("GHz", _GHz), REGISTER("MHz", _MHz), REGISTER("kHz", _kHz),
+			REGISTER("Hz",       _Hz),  REGISTER("mHz", _mHz), REGISTER("Bq",  _Bq),
+			// force, energy, and power in...
+			REGISTER("MN",       _MN),  REGISTER("kN",  _kN),  REGISTER("N",   _N),   REGISTER("mN",  _mN),
+			REGISTER("Nm",       _Nm),  REGISTER("PJ",  _PJ),  REGISTER("TJ",  _TJ),  REGISTER("GJ",  _GJ),
+			REGISTER("MJ",       _MJ),  REGISTER("kJ",  _kJ),  REGISTER("J",   _J),   REGISTER("mJ",  _mJ),
+			REGISTER("eV",       _eV),  REGISTER("cal", _cal), REGISTER("kcal", _kcal),
+			REGISTER("TW",       _TW),  REGISTER("GW",  _GW),  REGISTER("MW",  _MW),  REGISTER("kW",  _kW),
+			REGISTER("W",        _W),   REGISTER("mW",  _mW),  REGISTER("hp",  _hp),  REGISTER("PS",  _PS),
+			// pressure in...
+			REGISTER("MPa",      _MPa), REGISTER("kPa", _kPa), REGISTER("hPa", _hPa), REGISTER("Pa",  _Pa),
+			REGISTER("mPa",      _mPa), REGISTER("bar", _bar), REGISTER("mbar", _mbar), REGISTER("psi", _psi),
+			REGISTER("atm",      _atm), REGISTER("inHg", _inHg), REGISTER("mmHg", _mmHg), REGISTER("Torr", _Torr),
+			// electric units in...
+			REGISTER("MV",       _MV),  REGISTER("kV",  _kV),  REGISTER("V",   _V),   REGISTER("mV",  _mV),
+			REGISTER("uV",       _uV),  REGISTER("C",   _C),   REGISTER("Ah",  _Ah),  REGISTER("mAh", _mAh),
+			REGISTER("MOhm",     _MOhm), REGISTER("kOhm", _kOhm), REGISTER("Ohm", _Ohm), REGISTER("Ω", _Ohm),
+			REGISTER("S",        _S),   REGISTER("F",   _F),   REGISTER("mF",  _mF),  REGISTER("uF",  _uF),
+			REGISTER("nF",       _nF),  REGISTER("pF",  _pF),  REGISTER("H",   _H),   REGISTER("mH",  _mH),
+			REGISTER("Wb",       _Wb),  REGISTER("T",   _T),   REGISTER("mT",  _mT),  REGISTER("uT",  _uT),
+			// density and various units in...
+			REGISTER("kg/m³",    _kg_per_m³), REGISTER("g/cm³", _g_per_cm³), REGISTER("kg/m²", _kg_per_m²),
+			REGISTER("Gy",       _Gy),  REGISTER("Sv",  _Sv),  REGISTER("mSv", _mSv), REGISTER("lm",  _lm),
+			REGISTER("lx",       _lx),  REGISTER("rad", _rad), REGISTER("deg", _deg), REGISTER("°",   _deg),
+			REGISTER("sr",       _sr),  REGISTER("%",   _percent), REGISTER("B", _byte), REGISTER("kB", _kB),
+			REGISTER("MB",       _MB),  REGISTER("GB",  _GB),  REGISTER("TB",  _TB),
+			// temperature with offset in...
+			{ "°C",   { exponents_of<temperature_dimension>(), 1.0, 273.15 } },
+			{ "degC", { exponents_of<temperature_dimension>(), 1.0, 273.15 } },
+			{ "°F",   { exponents_of<temperature_dimension>(), 5.0 / 9.0, 459.67 * 5.0 / 9.0 } },
+			{ "degF", { exponents_of<temperature_dimension>(), 5.0 / 9.0, 459.67 * 5.0 / 9.0 } },
+		};
+
+#undef REGISTER
+
+		// FNV-1a hash of the symbol, seeded to find collision-free slots
+		constexpr std::uint32_t unit_hash(std::string_view symbol, std::uint32_t seed)
+		{
+			std::uint32_t hash = 2166136261u ^ (seed * 16777619u);
+			for (char c : symbol)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+		// Perfect hash ("hash and displace") over the registered units, built at compile-time:
+		// each bucket of keys gets a seed which moves all its keys into free slots.
+		struct unit_registry
+		{
+			static constexpr size_t count = sizeof(registered_units) / sizeof(registered_units[0]);
+			static constexpr size_t bucket_count = count / 2 + 1;
+			static constexpr size_t slot_count = 512; // (power of two with less than 50% load)
+			static_assert(count < slot_count / 2, "too many registered units, please increase slot_count");
+
+			std::array<std::uint16_t, bucket_count> seeds{};
+			std::array<std::int16_t, slot_count> slots{};
+
+			// (hashes the symbols once to sort them into buckets, then once per tried seed of their bucket: about 0.5M
+			//  operations by GCC's count, above MSVC's default limit of 100k steps, see /constexpr:steps in CMakeLists.txt)
+			static constexpr unit_registry build()
+			{
+				unit_registry registry;
+				for (auto& slot : registry.slots)
+					slot = -1;
+
+				// sort the keys by bucket (counting sort), so each bucket is a range [begin[bucket], begin[bucket + 1])
+				std::array<size_t, bucket_count + 1> begin{};
+				std::array<size_t, count> bucket_of{}, keys{};
+				for (size_t i = 0; i < count; i++)
+					begin[(bucket_of[i] = unit_hash(registered_units[i].symbol, 0) % bucket_count) + 1]++;
+				size_t max_size = 0;
+				for (size_t bucket = 0; bucket < bucket_count; bucket++)
+				{
+					max_size = std::max(max_size, begin[bucket + 1]);
+					begin[bucket + 1] += begin[bucket];
+				}
+				std::array<size_t, bucket_count + 1> end = begin;
+				for (size_t i = 0; i < count; i++)
+					keys[end[bucket_of[i]]++] = i;
+
+				// place the biggest buckets first while most slots are free
+				std::array<size_t, count> slot_of{};
+				for (size_t size = max_size; size > 0; size--)
+				{
+					for (size_t bucket = 0; bucket < bucket_count; bucket++)
+					{
+						if (begin[bucket + 1] - begin[bucket] != size)
+							continue;
+						// (a symbol registered twice would never get a slot of its own, so it's left out and
+						//  has_unique_symbols() below fails)
+						size_t n = 0;
+						for (size_t k = begin[bucket]; k < begin[bucket + 1]; k++)
+						{
+							bool duplicate = false;
+							for (size_t j = begin[bucket]; j < begin[bucket] + n && !duplicate; j++)
+								duplicate = registered_units[keys[j]].symbol == registered_units[keys[k]].symbol;
+							if (!duplicate)
+								keys[begin[bucket] + n++] = keys[k];
+						}
+						for (std::uint16_t seed = 1; ; seed++)
+						{
+							bool ok = true;
+							for (size_t j = 0; j < n && ok; j++)
+							{
+								const size_t slot = unit_hash(registered_units[keys[begin[bucket] + j]].symbol, seed) % slot_count;
+								ok = registry.slots[slot] < 0;
+								for (size_t i = 0; i < j && ok; i++)
+									ok = slot_of[i] != slot;
+								slot_of[j] = slot;
+							}
+							if (!ok)
+								continue;
+							for (size_t j = 0; j < n; j++)
+								registry.slots[slot_of[j]] = static_cast<std::int16_t>(keys[begin[bucket] + j]);
+							registry.seeds[bucket] = seed;
+							break;
+						}
+					}
+				}
+				return registry;
+			}
+
+			constexpr const runtime_unit* find(std::string_view symbol) const
+			{
+				const auto seed = seeds[unit_hash(symbol, 0) % bucket_count];
+				const auto index = slots[unit_hash(symbol, seed) % slot_count];
+				if (index < 0 || registered_units[index].symbol != symbol)
+					return nullptr;
+				return &registered_units[index].unit;
+			}
+		};
+
+		constexpr unit_registry registry = unit_registry::build();
+
+		// (every symbol finds its own unit, so none was left out as registered twice)
+		constexpr bool has_unique_symbols()
+		{
+			for (size_t i = 0; i < unit_registry::count; i++)
+				if (registry.find(registered_units[i].symbol) != &registered_units[i].unit)
+					return false;
+			return true;
+		}
+		static_assert(has_unique_symbols(), "unit symbols must be registered once only");
+
+		// Parses one term of a composite unit such as "m", "m²", "s^2", or "s^-1" into the result (multiplying).
+		bool parse_unit_term(std::string_view term, int sign, runtime_unit& result)
+		{
+			int exponent = 1;
+			const runtime_unit* unit = registry.find(term);
+			if (unit == nullptr)
+			{
+				if (const auto caret = term.find('^'); caret != std::string_view::npos)
+				{
+					std::string_view digits = term.substr(caret + 1);
+					const bool negative = !digits.empty() && digits[0] == '-';
+					if (negative)
+						digits.remove_prefix(1);
+					if (digits.empty() || digits.size() > 2)
+						return false;
+					exponent = 0;
+					for (char c : digits)
+					{
+						if (c < '0' || c > '9')
+							return false;
+						exponent = exponent * 10 + (c - '0');
+					}
+					if (negative)
+						exponent = -exponent;
+					term = term.substr(0, caret);
+				}
+				else if (term.size() > 2 && (term.substr(term.size() - 2) == "²" || term.substr(term.size() - 2) == "³"))
+				{
+					exponent = (term.substr(term.size() - 2) == "²") ? 2 : 3;
+					term.remove_suffix(2);
+				}
+				unit = registry.find(term);
+			}
+			if (unit == nullptr || unit->offset != 0.0)
+				return false; // unknown or with offset (e.g. °C is fine alone, but not in composite units)
+
+			exponent *= sign;
+			for (size_t i = 0; i < result.dimension.size(); i++)
+				result.dimension[i] = static_cast<signed char>(result.dimension[i] + exponent * unit->dimension[i]);
+			for (int i = 0; i < exponent; i++)
+				result.factor *= unit->factor;
+			for (int i = 0; i > exponent; i--)
+				result.factor /= unit->factor;
+			return true;
+		}
+
+		// Parses composite units such as "kg*m/s^2" or "W/m²/K" (each '/' divides by the next term only).
+		bool parse_composite_unit(std::string_view text, runtime_unit& result)
+		{
+			SI_PROFILE_SCOPE("parse_composite_unit");
+			result = { {}, 1.0, 0.0 };
+			int sign = 1;
+			while (!text.empty())
+			{
+				size_t end = 0, separator_size = 0;
+				int next_sign = 1;
+				for (; end < text.size(); end++)
+				{
+					if (text[end] == '*' || text[end] == '/')
+					{
+						separator_size = 1;
+						next_sign = (text[end] == '/') ? -1 : 1;
+						break;
+					}
+					if (text.substr(end, 2) == "·")
+					{
+						separator_size = 2;
+						break;
+					}
+				}
+				if (!parse_unit_term(text.substr(0, end), sign, result))
+					return false;
+				text.remove_prefix(std::min(text.size(), end + separator_size));
+				if (separator_size > 0 && text.empty())
+					return false; // trailing operator
+				sign = next_sign;
+			}
+			return true;
+		}
+	}
+
+	// Returns the registered unit of the given symbol such as "km/h" (or nullptr if unknown), takes a single hashed lookup.
+	const runtime_unit* find_unit(std::string_view symbol)
+	{
+		return detail::registry.find(symbol);
+	}
+
+	namespace detail
+	{
+		// a direct-mapped cache of parsed composite units, per thread: bounded in size (a new unit replaces the one in its
+		// slot), successful parses of short units only (so arbitrary input can't fill it), looked up without allocations
+		class composite_unit_cache
+		{
+		public:
+			static constexpr size_t slots = 64;
+			static constexpr size_t max_length = 32;
+
+			const runtime_unit* find(std::string_view text) const
+			{
+				const entry& e = m_entries[slot_of(text)];
+				return e.used && e.text == text ? &e.unit : nullptr;
+			}
+
+			void insert(std::string_view text, const runtime_unit& unit)
+			{
+				if (text.size() > max_length)
+					return;
+				entry& e = m_entries[slot_of(text)];
+				e.text.assign(text.data(), text.size()); // (reuses the capacity of the replaced unit)
+				e.unit = unit;
+				e.used = true;
+			}
+
+		private:
+			struct entry
+			{
+				std::string text;
+				runtime_unit unit;
+				bool used = false;
+			};
+			std::array<entry, slots> m_entries;
+
+			static size_t slot_of(std::string_view text) { return std::hash<std::string_view>()(text) % slots; }
+		};
+	}
+
+	// Parses a registered or a composite unit such as "kg*m/s^2", composite units are parsed once per thread (then cached).
+	bool parse_unit(std::string_view text, runtime_unit& result)
+	{
+		SI_PROFILE_SCOPE("parse_unit");
+		if (const auto* unit = find_unit(text))
+		{
+			result = *unit;
+			return true;
+		}
+
+		thread_local detail::composite_unit_cache composites;
+		if (const auto* unit = composites.find(text))
+		{
+			result = *unit;
+			return true;
+		}
+		if (!detail::parse_composite_unit(text, result))
+			return false; // (invalid units aren't cached)
+		composites.insert(text, result);
+		return true;
+	}
+
+	// Converts the number given in the unit (e.g. 12.0 in "km/h") into the SI datatype, fails on unknown or wrong units.
+	template <class Dimension>
+	bool from_unit(SIdouble number, std::string_view unit, detail::quantity<Dimension, SIdouble>& result)
+	{
+		SI_PROFILE_SCOPE("from_unit");
+		runtime_unit u;
+		if (!parse_unit(unit, u) || u.dimension != detail::exponents_of<Dimension>())
+			return false;
+
+		result = detail::quantity<Dimension, SIdouble>(Dimension(), number * u.factor + u.offset);
+		return true;
+	}
+
+	// Converts the number given in the unit into a dimensionless value (e.g. 50.0 in "%"), fails on unknown or wrong units.
+	bool from_unit(SIdouble number, std::string_view unit, dimensionless& result)
+	{
+		SI_PROFILE_SCOPE("from_unit");
+		runtime_unit u;
+		if (!parse_unit(unit, u) || u.dimension != detail::exponents_of<detail::dimensionless>())
+			return false;
+
+		result = number * u.factor + u.offset;
+		return true;
+	}
+} // namespace SI
+
+// References
+// ----------
+// 1. http://cmph.sourceforge.net/papers/esa09.pdf (Hash, displace, and compress)
+// 2. http://www.isthe.com/chongo/tech/comp/fnv/ (FNV hash)
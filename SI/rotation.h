@@ -0,0 +1,229 @@
+// <SI/rotation.h> - 3x3 matrices and unit quaternions for 3D quantities, e.g. rotate(attitude, meters(1.0, 0.0, 0.0))
+//                   (value types for quantity like vec3, so transforms keep the dimension, and batched kernels for spans)
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <SI/aligned.h>
+
+namespace SI
+{
+	namespace internal
+	{
+		// A 3x3 matrix of rows x, y, z, e.g. a rotation (dimensionless) or an inertia tensor (as quantity in kg·m²).
+		template <class T>
+		struct mat3
+		{
+			static_assert(std::is_arithmetic_v<T>);
+
+			vec3<T> x; // (1st row)
+			vec3<T> y; // (2nd row)
+			vec3<T> z; // (3rd row)
+
+			constexpr mat3() = default;
+
+			constexpr mat3(const vec3<T>& x, const vec3<T>& y, const vec3<T>& z) : x(x), y(y), z(z) {}
+
+			static constexpr mat3 identity() { return { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }; }
+
+			static constexpr mat3 diagonal(const vec3<T>& d) { return { { d.x, 0, 0 }, { 0, d.y, 0 }, { 0, 0, d.z } }; }
+		};
+
+		// A unit quaternion w + xi + yj + zk representing a rotation (the default is no rotation). Unlike a mat3 it
+		// stays a rotation under rounding when renormalized, and interpolates and integrates cheaply.
+		template <class T = SIdouble>
+		struct quat
+		{
+			static_assert(std::is_floating_point_v<T>);
+
+			T w = 1;
+			T x = 0;
+			T y = 0;
+			T z = 0;
+
+			constexpr quat() = default;
+
+			constexpr quat(T w, T x, T y, T z) : w(w), x(x), y(y), z(z) {}
+
+			constexpr quat(T w, const vec3<T>& v) : w(w), x(v.x), y(v.y), z(v.z) {}
+
+			constexpr vec3<T> vector() const { return { x, y, z }; }
+		};
+
+		// +++ mat3 +++
+		template <class T> [[nodiscard]] constexpr mat3<T> operator-(const mat3<T>& m) { return { -m.x, -m.y, -m.z }; }
+		template <class T, class U> [[nodiscard]] constexpr bool operator==(const mat3<T>& lhs, const mat3<U>& rhs) { return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z; }
+		template <class T, class U> [[nodiscard]] constexpr bool operator!=(const mat3<T>& lhs, const mat3<U>& rhs) { return !(lhs == rhs); }
+
+		template <class T> [[nodiscard]] constexpr mat3<T> operator+(const mat3<T>& lhs, const mat3<T>& rhs) { return { lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z }; }
+		template <class T> [[nodiscard]] constexpr mat3<T> operator-(const mat3<T>& lhs, const mat3<T>& rhs) { return { lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z }; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr mat3<T> operator*(const mat3<T>& lhs, U rhs) { return { lhs.x * rhs, lhs.y * rhs, lhs.z * rhs }; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr mat3<T> operator*(U lhs, const mat3<T>& rhs) { return rhs * lhs; }
+		template <class T, class U, class = enable_for_scalar<U>> [[nodiscard]] constexpr mat3<T> operator/(const mat3<T>& lhs, U rhs) { return { lhs.x / rhs, lhs.y / rhs, lhs.z / rhs }; }
+
+		// matrix times column vector
+		template <class T, class U> [[nodiscard]] constexpr vec3<detail::vec_common_type_t<T, U>> operator*(const mat3<T>& m, const vec3<U>& v) { return { dot(m.x, v), dot(m.y, v), dot(m.z, v) }; }
+
+		// matrix product (applies rhs first, then lhs)
+		template <class T> [[nodiscard]] constexpr mat3<T> operator*(const mat3<T>& lhs, const mat3<T>& rhs)
+		{
+			return { rhs.x * lhs.x.x + rhs.y * lhs.x.y + rhs.z * lhs.x.z, rhs.x * lhs.y.x + rhs.y * lhs.y.y + rhs.z * lhs.y.z, rhs.x * lhs.z.x + rhs.y * lhs.z.y + rhs.z * lhs.z.z };
+		}
+
+		// matrix times N column vectors at once (lanewise, vectorizes over the tile)
+		template <class T, size_t N> [[nodiscard]] constexpr tile3<T, N> operator*(const mat3<T>& m, const tile3<T, N>& v)
+		{
+			return { v.x * m.x.x + v.y * m.x.y + v.z * m.x.z, v.x * m.y.x + v.y * m.y.y + v.z * m.y.z, v.x * m.z.x + v.y * m.z.y + v.z * m.z.z };
+		}
+
+		template <class T> [[nodiscard]] constexpr mat3<T> transpose(const mat3<T>& m) { return { { m.x.x, m.y.x, m.z.x }, { m.x.y, m.y.y, m.z.y }, { m.x.z, m.y.z, m.z.z } }; }
+		template <class T> [[nodiscard]] constexpr T determinant(const mat3<T>& m) { return dot(m.x, cross(m.y, m.z)); }
+
+		// +++ quat +++
+		template <class T> [[nodiscard]] constexpr bool operator==(const quat<T>& lhs, const quat<T>& rhs) { return lhs.w == rhs.w && lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z; }
+		template <class T> [[nodiscard]] constexpr bool operator!=(const quat<T>& lhs, const quat<T>& rhs) { return !(lhs == rhs); }
+
+		// Hamilton product, the rotation rhs followed by lhs
+		template <class T> [[nodiscard]] constexpr quat<T> operator*(const quat<T>& lhs, const quat<T>& rhs)
+		{
+			return { lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
+				lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+				lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+				lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w };
+		}
+
+		template <class T> [[nodiscard]] constexpr T dot(const quat<T>& lhs, const quat<T>& rhs) { return lhs.w * rhs.w + lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z; }
+		template <class T> [[nodiscard]] constexpr quat<T> conjugate(const quat<T>& q) { return { q.w, -q.x, -q.y, -q.z }; } // (the inverse rotation)
+		template <class T> [[nodiscard]] inline quat<T> normalize(const quat<T>& q) { const T l = std::sqrt(dot(q, q)); return { q.w / l, q.x / l, q.y / l, q.z / l }; }
+
+		// Returns the rotation by the angle (right-handed) around the axis of unit length, e.g. rotation({ 0, 0, 1 }, 90_deg).
+		[[nodiscard]] inline quat<SIdouble> rotation(const vec3<SIdouble>& axis, angle a)
+		{
+			const SIdouble half = a / 2;
+			return { std::cos(half), axis * std::sin(half) };
+		}
+
+		// Returns the vector rotated by the unit quaternion (as v + 2w(u×v) + 2u×(u×v) for u = (x, y, z), 15
+		// multiplications instead of the 28 of q·v·q*).
+		template <class T, class U>
+		[[nodiscard]] constexpr vec3<detail::vec_common_type_t<T, U>> rotate(const quat<T>& q, const vec3<U>& v)
+		{
+			const vec3<T> u = q.vector();
+			const auto t = cross(u, v) * 2;
+			return v + t * q.w + cross(u, t);
+		}
+
+		// Returns the rotation matrix of the unit quaternion (for rotating many vectors, 9 multiplications each).
+		template <class T>
+		[[nodiscard]] constexpr mat3<T> matrix(const quat<T>& q)
+		{
+			const T x2 = q.x * 2, y2 = q.y * 2, z2 = q.z * 2;
+			const T xx = q.x * x2, yy = q.y * y2, zz = q.z * z2, xy = q.x * y2, xz = q.x * z2, yz = q.y * z2, wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+			return { { 1 - yy - zz, xy - wz, xz + wy }, { xy + wz, 1 - xx - zz, yz - wx }, { xz - wy, yz + wx, 1 - xx - yy } };
+		}
+
+		template <class T, size_t N>
+		[[nodiscard]] constexpr tile3<T, N> rotate(const quat<T>& q, const tile3<T, N>& v)
+		{
+			return matrix(q) * v;
+		}
+
+		// (for quantity::infinity() and NaN())
+		template <class T>
+		constexpr void fill(mat3<T>& m, T value)
+		{
+			m.x = m.y = m.z = { value, value, value };
+		}
+	}
+
+	namespace detail
+	{
+		template <class T> struct scalar_value_type<internal::mat3<T>> { using type = T; };
+		template <class T> struct is_arithmetic<internal::mat3<T>> : std::true_type {}; // (for units, e.g. kilograms(mat3<SIdouble>::identity()))
+	}
+
+	using internal::mat3;
+	using internal::quat;
+	using internal::rotation;
+	using internal::matrix;
+	using internal::conjugate;
+	using internal::transpose;
+	using internal::determinant;
+
+	// Returns the 3D quantity (or tile of them) rotated by the unit quaternion, e.g. rotate(attitude, 1_m * forward).
+	template <class T, class Dimension, class V>
+	constexpr detail::quantity<Dimension, V> rotate(const quat<T>& q, const detail::quantity<Dimension, V>& v)
+	{
+		return { Dimension(), rotate(q, value(v)) };
+	}
+
+	// Returns the orientation after turning with the angular velocity (in the world frame) for the time step, e.g.
+	// integrate(attitude, radians_per_second(0.0, 0.0, 1.0), 10_ms). The update is the exact rotation by |ω|·dt around
+	// ω for a constant angular velocity (no first-order drift as with q + dt/2·ω·q), renormalized against rounding.
+	// (angular speeds are in rad/s, frequencies in Hz are cycles per second and don't convert implicitly: 2π rad/s per Hz)
+	template <class T>
+	inline quat<T> integrate(const quat<T>& q, const detail::quantity<detail::angular_speed_dimension, detail::vec3<T>>& angular_velocity, time dt)
+	{
+		const detail::vec3<T> omega = value(angular_velocity);
+		const T speed = internal::length(omega), half = speed * value(dt) / 2;
+		const T s = speed > 0 ? std::sin(half) / speed : value(dt) / 2; // (sin(|ω|dt/2) / |ω|)
+		return internal::normalize(quat<T>(std::cos(half), omega * s) * q);
+	}
+
+	// Transforms many 3D quantities (or tiles of them) by the matrix, e.g. transform(inertia, angular_velocities,
+	// angular_momenta). Dimensions multiply as for single values, an AoSoA span of tile3 vectorizes best.
+	template <class M, class In, class Out, class Q = detail::element_of_t<const In>>
+	void transform(const M& m, const In& in, Out& out)
+	{
+		const span<const Q> x(in);
+		const span<decltype(m * std::declval<const Q&>())> y(out);
+		assert(y.size() >= x.size());
+		SI_CHECK_FP("transform", M, Q);
+		for (size_t i = 0; i < x.size(); i++)
+			y[i] = m * x[i];
+	}
+
+	// Transforms many 3D quantities by the matrix, multithreaded for very large batches.
+	template <class M, class In, class Out, class Q = detail::element_of_t<const In>>
+	void transform(const parallel_t& policy, const M& m, const In& in, Out& out)
+	{
+		const span<const Q> x(in);
+		const span<decltype(m * std::declval<const Q&>())> y(out);
+		assert(y.size() >= x.size());
+		SI_CHECK_FP("transform", M, Q);
+		detail::parallel_for(policy, x.size(), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+				y[i] = m * x[i];
+		});
+	}
+
+	// Rotates many 3D quantities (or tiles of them) by the unit quaternion, e.g. rotate(attitude, positions, rotated)
+	// (converts it to a matrix once, then it's 9 multiplications per vector).
+	template <class T, class In, class Out, class Q = detail::element_of_t<const In>>
+	void rotate(const quat<T>& q, const In& in, Out& out)
+	{
+		transform<mat3<T>, In, Out, Q>(matrix(q), in, out);
+	}
+
+	template <class T, class In, class Out, class Q = detail::element_of_t<const In>>
+	void rotate(const parallel_t& policy, const quat<T>& q, const In& in, Out& out)
+	{
+		transform<mat3<T>, In, Out, Q>(policy, matrix(q), in, out);
+	}
+
+	// Turns many orientations by their angular velocities for the time step, like integrate() (e.g. rigid bodies).
+	inline void integrate(span<quat<SIdouble>> orientations, span<const angular_speed3> angular_velocities, time dt)
+	{
+		assert(angular_velocities.size() >= orientations.size());
+		SI_CHECK_FP("integrate", angular_speed3, time);
+		for (size_t i = 0; i < orientations.size(); i++)
+			orientations[i] = integrate(orientations[i], angular_velocities[i], dt);
+	}
+
+} // namespace SI
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/Quaternions_and_spatial_rotation
+// 2. https://en.wikipedia.org/wiki/Rotation_matrix#Quaternion
+// 3. https://fgiesen.wordpress.com/2019/02/09/rotating-a-single-vector-using-a-quaternion/ (the 15 multiplications)
@@ -0,0 +1,454 @@
+// <SI/spatial.h> - spatial indexes over point sets, e.g. SI::spatial::kd_tree(points).nearest(meters(1.0, 2.0, 3.0), 5)
+//                  (neighbor searches by radius or count, returning the point indexes and their distances)
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <vector>
+#include <SI/batch.h>
+
+namespace SI { namespace spatial {
+
+	// a point found by a query
+	struct neighbor
+	{
+		size_t index; // (into the points the index was built from)
+		length distance;
+	};
+
+	namespace detail
+	{
+		struct point
+		{
+			SIdouble coordinates[3];
+			uint32_t index;
+		};
+
+		std::vector<point> points_of(span<const length3> points)
+		{
+			std::vector<point> result(points.size());
+			for (size_t i = 0; i < points.size(); i++)
+			{
+				const auto& p = value(points[i]);
+				result[i] = { { p.x, p.y, p.z }, static_cast<uint32_t>(i) };
+			}
+			return result;
+		}
+
+		// the k nearest candidates found so far, the farthest on top
+		class nearest_candidates
+		{
+		public:
+			explicit nearest_candidates(size_t k) : m_k(k) {}
+
+			void add(SIdouble distance2, uint32_t index)
+			{
+				if (m_heap.size() < m_k)
+					m_heap.push({ distance2, index });
+				else if (distance2 < m_heap.top().first)
+				{
+					m_heap.pop();
+					m_heap.push({ distance2, index });
+				}
+			}
+
+			bool full() const { return m_heap.size() == m_k; }
+			SIdouble max_distance2() const { return full() ? m_heap.top().first : std::numeric_limits<SIdouble>::infinity(); }
+
+			std::vector<neighbor> sorted()
+			{
+				std::vector<neighbor> result(m_heap.size());
+				for (size_t i = result.size(); i-- > 0; m_heap.pop())
+					result[i] = { m_heap.top().second, meters(std::sqrt(m_heap.top().first)) };
+				return result;
+			}
+
+		private:
+			size_t m_k;
+			std::priority_queue<std::pair<SIdouble, uint32_t>> m_heap;
+		};
+
+		std::vector<neighbor> sorted(std::vector<std::pair<SIdouble, uint32_t>>& found)
+		{
+			std::sort(found.begin(), found.end());
+			std::vector<neighbor> result(found.size());
+			for (size_t i = 0; i < found.size(); i++)
+				result[i] = { found[i].second, meters(std::sqrt(found[i].first)) };
+			return result;
+		}
+	}
+
+	// A k-d tree, balanced and implicit: the points are stored in tree order as SoA arrays (no nodes, no pointers).
+	class kd_tree
+	{
+	public:
+		explicit kd_tree(span<const length3> points)
+		{
+			build(nullptr, points);
+		}
+
+		// Builds the tree multithreaded (the subtrees are built by separate threads).
+		kd_tree(const parallel_t& policy, span<const length3> points)
+		{
+			build(&policy, points);
+		}
+
+		size_t size() const { return m_indices.size(); }
+
+		// Returns all points within the radius around the center, sorted by distance.
+		std::vector<neighbor> within(const length3& center, length radius) const
+		{
+			const auto& c = value(center);
+			const SIdouble query[3] = { c.x, c.y, c.z };
+			std::vector<std::pair<SIdouble, uint32_t>> found;
+			within(query, value(radius) * value(radius), 0, size(), found);
+			return detail::sorted(found);
+		}
+
+		// Returns the k nearest points to the center, sorted by distance.
+		std::vector<neighbor> nearest(const length3& center, size_t k) const
+		{
+			const auto& c = value(center);
+			const SIdouble query[3] = { c.x, c.y, c.z };
+			detail::nearest_candidates candidates(k);
+			if (k > 0)
+				nearest(query, 0, size(), candidates);
+			return candidates.sorted();
+		}
+
+	private:
+		// (the median of [begin, end) is at the middle, the points before it are on its lower side along m_axes[middle])
+		std::vector<SIdouble> m_coordinates[3];
+		std::vector<uint32_t> m_indices;
+		std::vector<uint8_t> m_axes;
+
+		void build(const parallel_t* policy, span<const length3> points)
+		{
+			std::vector<detail::point> sorted = detail::points_of(points);
+			m_axes.resize(sorted.size());
+			const size_t threads = policy != nullptr ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+			build(sorted, 0, sorted.size(), threads, policy != nullptr ? policy->min_batch : 0);
+
+			for (auto& coordinates : m_coordinates)
+				coordinates.resize(sorted.size());
+			m_indices.resize(sorted.size());
+			for (size_t i = 0; i < sorted.size(); i++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+					m_coordinates[axis][i] = sorted[i].coordinates[axis];
+				m_indices[i] = sorted[i].index;
+			}
+		}
+
+		void build(std::vector<detail::point>& points, size_t begin, size_t end, size_t threads, size_t min_batch)
+		{
+			if (end - begin <= 1)
+				return;
+			SIdouble min[3], max[3]; // (split along the largest extent)
+			for (int axis = 0; axis < 3; axis++)
+				min[axis] = max[axis] = points[begin].coordinates[axis];
+			for (size_t i = begin + 1; i < end; i++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					min[axis] = std::min(min[axis], points[i].coordinates[axis]);
+					max[axis] = std::max(max[axis], points[i].coordinates[axis]);
+				}
+			}
+			int axis = 0;
+			for (int a = 1; a < 3; a++)
+			{
+				if (max[a] - min[a] > max[axis] - min[axis])
+					axis = a;
+			}
+			const size_t middle = begin + (end - begin) / 2;
+			std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end,
+				[axis](const detail::point& a, const detail::point& b) { return a.coordinates[axis] < b.coordinates[axis]; });
+			m_axes[middle] = static_cast<uint8_t>(axis);
+
+			if (threads > 1 && end - begin >= 2 * min_batch)
+			{
+				std::thread lower([&] { build(points, begin, middle, threads / 2, min_batch); });
+				build(points, middle + 1, end, threads - threads / 2, min_batch);
+				lower.join();
+			}
+			else
+			{
+				build(points, begin, middle, 1, min_batch);
+				build(points, middle + 1, end, 1, min_batch);
+			}
+		}
+
+		SIdouble distance2(const SIdouble query[3], size_t i) const
+		{
+			const SIdouble dx = m_coordinates[0][i] - query[0], dy = m_coordinates[1][i] - query[1], dz = m_coordinates[2][i] - query[2];
+			return dx * dx + dy * dy + dz * dz;
+		}
+
+		void within(const SIdouble query[3], SIdouble radius2, size_t begin, size_t end, std::vector<std::pair<SIdouble, uint32_t>>& found) const
+		{
+			if (begin >= end)
+				return;
+			const size_t middle = begin + (end - begin) / 2;
+			const SIdouble d2 = distance2(query, middle);
+			if (d2 <= radius2)
+				found.push_back({ d2, m_indices[middle] });
+			const SIdouble offset = query[m_axes[middle]] - m_coordinates[m_axes[middle]][middle];
+			if (offset <= 0 || offset * offset <= radius2)
+				within(query, radius2, begin, middle, found);
+			if (offset >= 0 || offset * offset <= radius2)
+				within(query, radius2, middle + 1, end, found);
+		}
+
+		void nearest(const SIdouble query[3], size_t begin, size_t end, detail::nearest_candidates& candidates) const
+		{
+			if (begin >= end)
+				return;
+			const size_t middle = begin + (end - begin) / 2;
+			candidates.add(distance2(query, middle), m_indices[middle]);
+			const SIdouble offset = query[m_axes[middle]] - m_coordinates[m_axes[middle]][middle];
+			const bool lower_first = offset < 0; // (the side of the query first, the other only if it may contain closer points)
+			nearest(query, lower_first ? begin : middle + 1, lower_first ? middle : end, candidates);
+			if (offset * offset < candidates.max_distance2())
+				nearest(query, lower_first ? middle + 1 : begin, lower_first ? end : middle, candidates);
+		}
+	};
+
+	// A uniform grid of cubic cells, hashed into buckets: the points are stored sorted by bucket as SoA arrays.
+	// Best for points of similar density and queries with radii about the cell size.
+	class uniform_grid
+	{
+	public:
+		uniform_grid(span<const length3> points, length cell_size)
+		{
+			build(nullptr, points, cell_size);
+		}
+
+		// Builds the grid multithreaded (the cells of the points are calculated in parallel).
+		uniform_grid(const parallel_t& policy, span<const length3> points, length cell_size)
+		{
+			build(&policy, points, cell_size);
+		}
+
+		size_t size() const { return m_indices.size(); }
+		length cell_size() const { return meters(m_cell_size); }
+
+		// Returns all points within the radius around the center, sorted by distance (searching the occupied cells
+		// overlapping the radius, or scanning all points if there are more of these cells than points).
+		std::vector<neighbor> within(const length3& center, length radius) const
+		{
+			const auto& c = value(center);
+			const SIdouble query[3] = { c.x, c.y, c.z }, r = value(radius);
+			std::vector<std::pair<SIdouble, uint32_t>> found;
+			auto add = [&](SIdouble d2, uint32_t index) { if (d2 <= r * r) found.push_back({ d2, index }); };
+			int32_t min[3], max[3];
+			SIdouble cells = 1;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::max(cell_of(query[axis] - r), m_min_cell[axis]);
+				max[axis] = std::min(cell_of(query[axis] + r), m_max_cell[axis]);
+				cells *= std::max(SIdouble(max[axis]) - SIdouble(min[axis]) + 1, 0.0);
+			}
+			if (size() == 0 || cells == 0)
+				return {};
+			if (cells > SIdouble(2 * size() + 27))
+				scan(query, add);
+			else
+			{
+				for (int32_t x = min[0]; x <= max[0]; x++)
+					for (int32_t y = min[1]; y <= max[1]; y++)
+						for (int32_t z = min[2]; z <= max[2]; z++)
+							visit(x, y, z, query, add);
+			}
+			return detail::sorted(found);
+		}
+
+		// Returns the k nearest points to the center, sorted by distance (searching shells of cells around the center,
+		// or scanning all points if that takes more cells than there are points, e.g. for a center far away).
+		std::vector<neighbor> nearest(const length3& center, size_t k) const
+		{
+			const auto& c = value(center);
+			const SIdouble query[3] = { c.x, c.y, c.z };
+			if (k == 0 || size() == 0)
+				return {};
+			detail::nearest_candidates candidates(std::min(k, size()));
+			int64_t cell[3], first_ring = 0, last_ring = 0; // (the shells overlapping the occupied cells)
+			for (int axis = 0; axis < 3; axis++)
+			{
+				cell[axis] = cell_of(query[axis]);
+				first_ring = std::max({ first_ring, m_min_cell[axis] - cell[axis], cell[axis] - m_max_cell[axis] });
+				last_ring = std::max({ last_ring, cell[axis] - m_min_cell[axis], m_max_cell[axis] - cell[axis] });
+			}
+			size_t cells = 0;
+			for (int64_t ring = first_ring; ring <= last_ring; ring++)
+			{
+				// (points outside of the shells searched so far are at least (ring - 1) * cell size away)
+				const SIdouble reach = static_cast<SIdouble>(ring - 1) * m_cell_size;
+				if (ring > 0 && candidates.full() && candidates.max_distance2() <= reach * reach)
+					break;
+				cells += shell_size(cell, ring);
+				if (cells > 2 * size() + 27)
+				{
+					detail::nearest_candidates all(std::min(k, size()));
+					scan(query, [&](SIdouble d2, uint32_t index) { all.add(d2, index); });
+					return all.sorted();
+				}
+				visit_shell(cell, ring, query, [&](SIdouble d2, uint32_t index) { candidates.add(d2, index); });
+			}
+			return candidates.sorted();
+		}
+
+	private:
+		SIdouble m_cell_size = 1, m_per_cell_size = 1;
+		size_t m_bucket_mask = 0;
+		std::vector<uint32_t> m_bucket_starts; // (the points of bucket b are [m_bucket_starts[b], m_bucket_starts[b + 1]))
+		std::vector<SIdouble> m_coordinates[3];
+		std::vector<int32_t> m_cells[3]; // (to tell apart the cells sharing a bucket)
+		int32_t m_min_cell[3] = {}, m_max_cell[3] = {}; // (the range of the occupied cells)
+		std::vector<uint32_t> m_indices;
+
+		int32_t cell_of(SIdouble coordinate) const
+		{
+			const SIdouble cell = std::floor(coordinate * m_per_cell_size);
+			return static_cast<int32_t>(std::fmin(std::fmax(cell, -2147483648.0), 2147483647.0)); // (saturated, NaN to the lowest)
+		}
+
+		size_t bucket_of(int32_t x, int32_t y, int32_t z) const
+		{
+			return ((uint64_t(uint32_t(x)) * 73856093u) ^ (uint64_t(uint32_t(y)) * 19349663u) ^ (uint64_t(uint32_t(z)) * 83492791u)) & m_bucket_mask;
+		}
+
+		// Returns the number of occupied-range cells of the shell at the Chebyshev distance ring around the cell.
+		size_t shell_size(const int64_t cell[3], int64_t ring) const
+		{
+			int64_t outer = 1, inner = 1;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				outer *= std::max<int64_t>(0, std::min<int64_t>(cell[axis] + ring, m_max_cell[axis]) - std::max<int64_t>(cell[axis] - ring, m_min_cell[axis]) + 1);
+				inner *= std::max<int64_t>(0, std::min<int64_t>(cell[axis] + ring - 1, m_max_cell[axis]) - std::max<int64_t>(cell[axis] - ring + 1, m_min_cell[axis]) + 1);
+			}
+			return static_cast<size_t>(outer - inner);
+		}
+
+		// Visits the points in the occupied-range cells of the shell at the Chebyshev distance ring around the cell
+		// (its six faces only, the cells inside belong to the shells before).
+		template <class Function>
+		void visit_shell(const int64_t cell[3], int64_t ring, const SIdouble query[3], Function&& function) const
+		{
+			int64_t min[3], max[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::max<int64_t>(cell[axis] - ring, m_min_cell[axis]);
+				max[axis] = std::min<int64_t>(cell[axis] + ring, m_max_cell[axis]);
+			}
+			for (int64_t x = min[0]; x <= max[0]; x++)
+				for (int64_t y = min[1]; y <= max[1]; y++)
+				{
+					if (std::abs(x - cell[0]) == ring || std::abs(y - cell[1]) == ring)
+					{
+						for (int64_t z = min[2]; z <= max[2]; z++)
+							visit(int32_t(x), int32_t(y), int32_t(z), query, function);
+						continue;
+					}
+					if (cell[2] - ring >= m_min_cell[2])
+						visit(int32_t(x), int32_t(y), int32_t(cell[2] - ring), query, function);
+					if (cell[2] + ring <= m_max_cell[2])
+						visit(int32_t(x), int32_t(y), int32_t(cell[2] + ring), query, function);
+				}
+		}
+
+		// Visits all points (instead of cells).
+		template <class Function>
+		void scan(const SIdouble query[3], Function&& function) const
+		{
+			for (size_t i = 0; i < size(); i++)
+			{
+				const SIdouble dx = m_coordinates[0][i] - query[0], dy = m_coordinates[1][i] - query[1], dz = m_coordinates[2][i] - query[2];
+				function(dx * dx + dy * dy + dz * dz, m_indices[i]);
+			}
+		}
+
+		template <class Function>
+		void visit(int32_t x, int32_t y, int32_t z, const SIdouble query[3], Function&& function) const
+		{
+			const size_t bucket = bucket_of(x, y, z);
+			for (uint32_t i = m_bucket_starts[bucket]; i < m_bucket_starts[bucket + 1]; i++)
+			{
+				if (m_cells[0][i] != x || m_cells[1][i] != y || m_cells[2][i] != z)
+					continue;
+				const SIdouble dx = m_coordinates[0][i] - query[0], dy = m_coordinates[1][i] - query[1], dz = m_coordinates[2][i] - query[2];
+				function(dx * dx + dy * dy + dz * dz, m_indices[i]);
+			}
+		}
+
+		void build(const parallel_t* policy, span<const length3> points, length cell_size)
+		{
+			assert(cell_size > 0_m);
+			m_cell_size = value(cell_size);
+			m_per_cell_size = 1 / m_cell_size;
+			size_t buckets = 1;
+			while (buckets < points.size())
+				buckets *= 2;
+			m_bucket_mask = buckets - 1;
+
+			// the cells and buckets of the points
+			const size_t count = points.size();
+			std::vector<int32_t> cells[3];
+			for (auto& c : cells)
+				c.resize(count);
+			std::vector<uint32_t> bucket(count);
+			auto loop = [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					const auto& p = value(points[i]);
+					cells[0][i] = cell_of(p.x), cells[1][i] = cell_of(p.y), cells[2][i] = cell_of(p.z);
+					bucket[i] = static_cast<uint32_t>(bucket_of(cells[0][i], cells[1][i], cells[2][i]));
+				}
+			};
+			if (policy != nullptr)
+				SI::detail::parallel_for(*policy, count, loop);
+			else
+				loop(0, count);
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const auto range = std::minmax_element(cells[axis].begin(), cells[axis].end());
+				m_min_cell[axis] = count > 0 ? *range.first : 0;
+				m_max_cell[axis] = count > 0 ? *range.second : 0;
+			}
+
+			// sort by bucket (counting sort)
+			m_bucket_starts.assign(buckets + 1, 0);
+			for (size_t i = 0; i < count; i++)
+				m_bucket_starts[bucket[i] + 1]++;
+			for (size_t b = 0; b < buckets; b++)
+				m_bucket_starts[b + 1] += m_bucket_starts[b];
+			std::vector<uint32_t> offsets(m_bucket_starts.begin(), m_bucket_starts.end() - 1);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				m_coordinates[axis].resize(count);
+				m_cells[axis].resize(count);
+			}
+			m_indices.resize(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				const uint32_t j = offsets[bucket[i]]++;
+				const auto& p = value(points[i]);
+				m_coordinates[0][j] = p.x, m_coordinates[1][j] = p.y, m_coordinates[2][j] = p.z;
+				m_cells[0][j] = cells[0][i], m_cells[1][j] = cells[1][i], m_cells[2][j] = cells[2][i];
+				m_indices[j] = static_cast<uint32_t>(i);
+			}
+		}
+	};
+
+} } // namespace SI::spatial
+
+// References
+// ----------
+// 1. https://en.wikipedia.org/wiki/K-d_tree
+// 2. https://en.wikipedia.org/wiki/Implicit_k-d_tree
+// 3. https://en.wikipedia.org/wiki/Grid_(spatial_index)
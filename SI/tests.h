@@ -3,6 +3,14 @@
 #pragma once
 #include <cassert>
 #include <SI/literals.h>
+#include <SI/registry.h>
+#include <SI/formulas.h>
+#include <SI/atmosphere.h>
+#include <SI/interval.h>
+#include <SI/dual.h>
+#include <SI/fast_math.h>
+#include <SI/rotation.h>
+#include <SI/accumulator.h>
 
 namespace SI { namespace tests {
 
@@ -267,19 +275,114 @@ namespace SI { namespace tests {
 	static_assert(square(1_m) == 1_m²);
 	static_assert(square(3_m) == 9_m²);
 
-	// static_assert(sqrt(9_m²) == 3_m); (TODO)
+	static_assert(sqrt(0_m²) == 0_m);
+	static_assert(sqrt(9_m²) == 3_m);
+	static_assert(pow<3>(2_m) == 8_m³);
+	static_assert(pow<5>(2_m) / 1_m³ == 32_m² && pow<-2>(2_s) == 0.25_Hz * 1_Hz && pow<0>(2_m) == 1);
+	static_assert(root<2>(9_m²) == 3_m && root<4>(16_m² * 1_m²) == 2_m);
 
 	static_assert(cube(0_m) == 0_m³);
 	static_assert(cube(1_m) == 1_m³);
 	static_assert(cube(3_m) == 27_m³);
 
-	// static_assert(cbrt(27_m³) == 3_m); (TODO)
+	static_assert(cbrt(27_m³) == 3_m);
+	static_assert(cbrt(-8_m³) == -2_m && root<3>(1_m³) == 1_m);
 
 	static_assert(clamp(-3_m, 4_m,5_m) == 4_m);
 	static_assert(clamp(3_m, 4_m,5_m) == 4_m);
 	static_assert(clamp(3_m, 1_m,2_m) == 2_m);
 	static_assert(clamp(0_m, -1_m,2_m) == 0_m);
 
+	// +++ UNIT RATIO CHECKS +++ (composed units are folded exactly at compile-time)
+	static_assert(std::is_same_v<const decltype(kilo * milli * meters), decltype(meters)>);
+	static_assert(std::is_same_v<decltype(kilometers3), const detail::unit<detail::volume_dimension, detail::ratio<1000000000, 1>>>);
+	static_assert(centimeters3(1.0) == 1_cm³);
+	static_assert(kilometers3(1.0) == 1_km³);
+	static_assert(grams_per_centimeter3(1.0) == 1_g_per_cm³);
+	static_assert(!detail::ratio_product<detail::ratio<1000000000000000000, 1>, detail::ratio<1000, 1>>::exact); // (overflows, falls back to floating point)
+
+	// +++ UNIT REGISTRY CHECKS +++
+	static_assert(detail::registry.find("km")->factor == 1000.0);
+	static_assert(detail::registry.find("km/h")->factor == value(1_km_per_h));
+	static_assert(detail::registry.find("kn")->dimension[0] == 1 && detail::registry.find("kn")->dimension[2] == -1);
+	static_assert(detail::registry.find("°C")->offset == 273.15);
+	static_assert(detail::registry.find("xyz") == nullptr);
+	static_assert(detail::registry.find("") == nullptr);
+
+	// +++ CONSTEXPR FORMULA CHECKS +++ (the math functions evaluate series at compile-time)
+	constexpr bool near(long double x, long double y, long double tolerance) { return x - y <= tolerance && y - x <= tolerance; }
+	static_assert(near(sin(constant::pi / 6), 0.5, 1e-15));
+	static_assert(near(cos(constant::pi / 3), 0.5, 1e-15));
+	static_assert(near(atan2(1_m, 1_m), constant::pi / 4, 1e-15));
+	static_assert(sizeof(angle) == sizeof(SIdouble) && std::is_same_v<decltype(sin(30_deg)), SIdouble>); // (no long double)
+	static_assert(near(sin(30_deg), 0.5, 1e-15) && 2 * 30_deg == 60_deg);
+	static_assert(std::is_same_v<decltype(30_deg + 15_deg), angle> && std::is_same_v<decltype(-30_deg), angle> && std::is_same_v<decltype(2.0 * 30_deg), angle>
+		&& std::is_same_v<decltype(30_deg * 2), angle> && std::is_same_v<decltype(30_deg / 2), angle> && std::is_same_v<decltype(60_deg / 30_deg), SIdouble>); // (angles print in degrees)
+	static_assert(near(constexpr_math::log10(1000.0), 3.0, 1e-15));
+	static_assert(near(constexpr_math::pow(2.0, 0.5), constexpr_math::sqrt(2.0), 1e-15));
+	static_assert(formula::hypotenuse_of_triangle(3_m, 4_m) == 5_m);
+	static_assert(formula::braking_distance(72_km_per_h, 0_km_per_h, 8_m_per_s²) == 25_m);
+	static_assert(abs(formula::speed_of_sound_in_air(20_degC) - 343.2_m_per_s) < 0.1_m_per_s);
+	static_assert(abs(formula::frequency_of_chromatic_note(12, 0, 440_Hz) - 880_Hz) < 1e-9_Hz);
+
+	// +++ ATMOSPHERE CHECKS +++ (the tropopause is at 11 km geopotential altitude, i.e. 11.019 km geometric)
+	static_assert(near(value(ISA::state_at(0_m).air_pressure), 101325, 1e-9) && near(value(ISA::state_at(0_m).air_temperature), 288.15, 1e-12));
+	constexpr length tropopause = 6356.766_km * 11_km / (6356.766_km - 11_km);
+	static_assert(near(value(ISA::state_at(tropopause).air_pressure), 22632, 1) && near(value(ISA::state_at(tropopause).air_temperature), 216.65, 1e-9));
+
+	// +++ INTERVAL CHECKS +++ (the results enclose the exact results, only slightly wider)
+	using interval = SI::interval<SIdouble>;
+	constexpr bool encloses(interval x, long double lower, long double upper) { return x.lower <= lower && x.upper >= upper && x.lower > lower - 1e-12 && x.upper < upper + 1e-12; }
+	static_assert(encloses(interval(1.0, 2.0) + interval(3.0, 4.0), 4, 6));
+	static_assert(encloses(interval(-1.0, 2.0) * interval(3.0, 4.0), -4, 8));
+	static_assert(encloses(1.0 / interval(2.0, 4.0), 0.25, 0.5));
+	static_assert(encloses(pow(interval(-2.0, 1.0), 2), 0, 4));
+	static_assert(encloses(sqrt(interval(4.0, 9.0)), 2, 3));
+	static_assert(interval(0.1).contains(0.1) && !(interval(1.0, 2.0) < interval(1.5, 3.0)));
+	static_assert(encloses(value(meters(interval(1.0, 2.0)) + 1_m), 2, 3));
+	static_assert(encloses(value(formula::braking_distance<interval>(meters_per_second(interval(19.0, 21.0)), 0_m_per_s, 8_m_per_s²)), 22.5625, 27.5625));
+	static_assert(encloses(value(formula::hypotenuse_of_triangle<interval>(meters(interval(3.0)), 4_m)), 5, 5));
+
+	// +++ AUTOMATIC DIFFERENTIATION CHECKS +++ (derivatives have the dimension of y / x)
+	constexpr auto v0 = variable<2>(20_m_per_s, 0);
+	constexpr auto deceleration = variable<2>(8_m_per_s², 1);
+	static_assert(derivative(formula::braking_distance<dual<SIdouble, 2>>(v0, 0_m_per_s, deceleration), v0) == 2.5_s);
+	static_assert(derivative(formula::braking_distance<dual<SIdouble, 2>>(v0, 0_m_per_s, deceleration), deceleration) == -3.125_s * 1_s);
+	static_assert(real(formula::kinetic_energy<dual<SIdouble, 2>>(2_kg, v0)) == 400_J);
+	static_assert(derivative(formula::kinetic_energy<dual<SIdouble, 2>>(2_kg, v0), v0) == 40_kg * 1_m_per_s);
+	static_assert(near(derivative(formula::hypotenuse_of_triangle<dual<SIdouble>>(variable<1>(3_m, 0), 4_m), variable<1>(3_m, 0)), 0.6, 1e-15));
+
+	// +++ FAST MATH CHECKS +++ (within the error bounds of <SI/fast_math.h>)
+	static_assert(near(fast::sin(30_deg), 0.5, 3e-8) && near(fast::cos(-120_deg), -0.5, 3e-8) && near(fast::tan(225_deg), 1, 4e-8));
+	static_assert(near(fast::sin(1000 * constant::pi + 0.5), 0.479425538604203, 3e-8) && near(fast::sin2(30_deg) + fast::cos2(30_deg), 1, 1e-7));
+	static_assert(fast::pow<3>(2_m) == 8_m³ && fast::pow<-1>(4_s) == 0.25_Hz && fast::pow<0>(2_m) == 1);
+
+	// +++ ALIGNED STORAGE CHECKS +++ (vec3a and tile3 compute the same as vec3)
+	static_assert(sizeof(vec3a<SIdouble>) == 32 && alignof(vec3a<SIdouble>) == 32 && alignof(tile3<SIdouble>) == 64);
+	static_assert(cross(meters(vec3a<SIdouble>(1, 0, 0)), meters(vec3a<SIdouble>(0, 2, 0))) == meters2(vec3a<SIdouble>(0, 0, 2)));
+	static_assert(dot(meters(vec3a<SIdouble>(1, 2, 3)), meters(vec3a<SIdouble>(4, 5, 6))) == 32_m²);
+	static_assert(length3(meters(vec3a<SIdouble>(1, 2, 3))) == meters(1.0, 2.0, 3.0));
+	constexpr tile3<SIdouble> tile_of(detail::vec3<SIdouble> v) { tile3<SIdouble> t; t.set(3, v); return t; }
+	static_assert(dot(tile_of({ 1, 2, 3 }), tile_of({ 4, 5, 6 }))[3] == 32 && cross(tile_of({ 1, 0, 0 }), tile_of({ 0, 1, 0 })).get(3) == detail::vec3<SIdouble>(0, 0, 1));
+	static_assert(value(lane(meters(tile_of({ 1, 2, 3 })) * 2.0, 3)) == detail::vec3<SIdouble>(2, 4, 6));
+
+	// +++ ROTATION CHECKS +++ (quat<>(0, 0, 0, 1) is the half turn around z)
+	static_assert(quat<>(0, 1, 0, 0) * quat<>(0, 0, 1, 0) == quat<>(0, 0, 0, 1)); // (i·j = k)
+	static_assert(rotate(quat<>(0, 0, 0, 1), meters(1.0, 2.0, 3.0)) == meters(-1.0, -2.0, 3.0));
+	static_assert(matrix(quat<>(0, 0, 0, 1)) * meters(1.0, 2.0, 3.0) == meters(-1.0, -2.0, 3.0));
+	static_assert(transpose(matrix(quat<>(0, 0, 0, 1))) == matrix(conjugate(quat<>(0, 0, 0, 1))) && determinant(mat3<SIdouble>::diagonal({ 2, 3, 4 })) == 24);
+	static_assert((1_kg * 1_m²) * mat3<SIdouble>::diagonal({ 1, 2, 3 }) * radians_per_second(1.0, 1.0, 1.0) == (1_kg * 1_m² / 1_s) * detail::vec3<SIdouble>(1, 2, 3));
+	template <class W, class = void> struct integrates : std::false_type {};
+	template <class W> struct integrates<W, std::void_t<decltype(integrate(quat<>(), std::declval<W>(), 1_s))>> : std::true_type {};
+	static_assert(!std::is_same_v<angular_speed, frequency> && !std::is_convertible_v<frequency, angular_speed> && !std::is_convertible_v<angular_speed, frequency>);
+	static_assert(integrates<angular_speed3>::value && !integrates<frequency3>::value); // (Hz would be off by 2π)
+	static_assert(2_rad_per_s * 0.5_s == 1 && 2_rad_per_s + 1_rad_per_s == 3_rad_per_s);
+
+	// +++ ACCUMULATOR CHECKS +++ (1 J is lost in a naive sum of 1e16 J + 1 J - 1e16 J)
+	template <class Q> constexpr Q compensated_sum(Q big, Q small) { accumulator<Q> a, b; a += big; a += small; b += -big; a += b; return a.total(); }
+	static_assert(1e16_J + 1_J - 1e16_J == 0_J && compensated_sum(1e16_J, 1_J) == 1_J);
+	static_assert(compensated_sum(meters(1e16, 1.0, -1e16), meters(1.0, 1e-16, 1.0)) == meters(1.0, 1e-16, 1.0));
+
 } } // namespace SI::tests
  
 // References
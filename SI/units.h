@@ -61,6 +61,8 @@ namespace SI
 	UNIT(meters_per_second) = unit<velocity>();
 	UNIT(kilometers_per_hour) = kilometers / hours;
 	UNIT(millimeters_per_hour) = millimeters / hours;
+	// angular speed in...
+	UNIT(radians_per_second) = unit<angular_speed>();
 	// acceleration in...
 	UNIT(meters_per_second2) = unit<acceleration>();
 	// force in...
@@ -136,37 +138,70 @@ namespace SI
 	UNIT(bytes_per_second) = bytes / seconds;
 
 	// +++ ANGLE +++ (DIMENSIONLESS)
-	typedef long double angle;
+	// An angle in radians, stored as SIdouble (not long double, so the math runs in SSE/AVX registers and vectorizes)
+	// but as type of its own (so angles print in degrees). Converts from and to plain numbers implicitly.
+	class angle
+	{
+	public:
+		constexpr angle() = default;
+		constexpr angle(SIdouble radians) : m_radians(radians) {} // NOLINT(google-explicit-constructor)
+		constexpr operator SIdouble() const { return m_radians; } // NOLINT(google-explicit-constructor)
+
+		constexpr angle& operator+=(SIdouble x) { m_radians += x; return *this; }
+		constexpr angle& operator-=(SIdouble x) { m_radians -= x; return *this; }
+		constexpr angle& operator*=(SIdouble x) { m_radians *= x; return *this; }
+		constexpr angle& operator/=(SIdouble x) { m_radians /= x; return *this; }
+
+		// (the arithmetic keeping angles, so results still print in degrees; angle ratios and products are plain numbers,
+		//  and the numbers are template parameters so that e.g. a / 2 isn't ambiguous with the built-in double / int)
+		friend constexpr angle operator+(angle a, angle b) { return a.m_radians + b.m_radians; }
+		friend constexpr angle operator-(angle a, angle b) { return a.m_radians - b.m_radians; }
+		friend constexpr angle operator-(angle a) { return -a.m_radians; }
+		friend constexpr angle operator+(angle a) { return a; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator+(angle a, U x) { return a.m_radians + x; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator+(U x, angle a) { return x + a.m_radians; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator-(angle a, U x) { return a.m_radians - x; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator-(U x, angle a) { return x - a.m_radians; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator*(angle a, U x) { return a.m_radians * x; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator*(U x, angle a) { return x * a.m_radians; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr angle operator/(angle a, U x) { return a.m_radians / x; }
+		template <class U, class = std::enable_if_t<std::is_arithmetic_v<U>>> friend constexpr SIdouble operator/(U x, angle a) { return x / a.m_radians; }
+		friend constexpr SIdouble operator*(angle a, angle b) { return a.m_radians * b.m_radians; }
+		friend constexpr SIdouble operator/(angle a, angle b) { return a.m_radians / b.m_radians; }
+
+	private:
+		SIdouble m_radians = 0;
+	};
 	typedef angle radians;
 
-	SI_INLINE angle sin(angle a)
+	SI_INLINE_CONSTEXPR SIdouble sin(angle a)
 	{
-		return std::sin(radians(a));
+		return constexpr_math::sin(SIdouble(a));
 	}
 
-	SI_INLINE angle cos(angle a)
+	SI_INLINE_CONSTEXPR SIdouble cos(angle a)
 	{
-		return std::cos(radians(a));
+		return constexpr_math::cos(SIdouble(a));
 	}
 
-	SI_INLINE angle tan(angle a)
+	SI_INLINE_CONSTEXPR SIdouble tan(angle a)
 	{
-		return std::tan(radians(a));
+		return constexpr_math::tan(SIdouble(a));
 	}
 
-	SI_INLINE angle atan2(length y, length x)
+	SI_INLINE_CONSTEXPR angle atan2(length y, length x)
 	{
-		return std::atan2(meters(y), meters(x));
+		return constexpr_math::atan2(value(y), value(x));
 	}
 
-	SI_INLINE angle sin2(angle x) // returns sin²x
+	SI_INLINE_CONSTEXPR SIdouble sin2(angle x) // returns sin²x
 	{
-		return 0.5 * (1.0 - std::cos(2.0 * x));
+		return 0.5 * (1.0 - constexpr_math::cos(2.0 * x));
 	}
 
-	SI_INLINE angle cos2(angle x) // returns cos²x
+	SI_INLINE_CONSTEXPR SIdouble cos2(angle x) // returns cos²x
 	{
-		return 0.5 * (1.0 + std::cos(2.0 * x));
+		return 0.5 * (1.0 + constexpr_math::cos(2.0 * x));
 	}
 
 	// +++ BASIC FUNCTIONS/TEMPLATES +++
@@ -0,0 +1,296 @@
+// benchmarks.cpp - measures the throughput of batched SI operations in nanoseconds per element
+//                  (build with optimizations, e.g. cmake -DCMAKE_BUILD_TYPE=Release, and add -march=native for AVX)
+#include <SI/all.h>
+#include <algorithm>
+#include <chrono>
+#include <cfenv>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+using namespace SI;
+
+constexpr size_t N = 1 << 16; // (elements per batch, fits into the L2 cache)
+
+// Runs the function repeatedly for about 0.2s and returns the nanoseconds per element.
+template <class Function>
+double measure(Function&& function)
+{
+	using clock = std::chrono::steady_clock;
+	function(); // (warm-up)
+	size_t runs = 0;
+	const auto start = clock::now();
+	auto elapsed = clock::duration();
+	for (; elapsed < std::chrono::milliseconds(200); elapsed = clock::now() - start)
+	{
+		function();
+		runs++;
+	}
+	return std::chrono::duration<double, std::nano>(elapsed).count() / double(runs * N);
+}
+
+void report(const char* name, double before, double after)
+{
+	std::printf("%-46s %9.2f ns %9.2f ns %7.1fx\n", name, before, after, before / after);
+}
+
+void report(const char* name, double before, double after, double max_error)
+{
+	std::printf("%-46s %9.2f ns %9.2f ns %7.1fx %10.1e\n", name, before, after, before / after, max_error);
+}
+
+// Returns the maximum absolute (or relative) error of the results compared to the long double reference.
+template <class Function, class Reference>
+double max_error(size_t count, Function&& function, Reference&& reference, bool relative)
+{
+	double error = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		const long double exact = reference(i), difference = std::fabs((long double)function(i) - exact);
+		error = std::max(error, double(relative ? difference / std::fabs(exact) : difference));
+	}
+	return error;
+}
+
+// Returns N uniformly distributed random values between min and max (in multiples of the unit).
+template <class T>
+std::vector<T> random_values(T unit, SIdouble min, SIdouble max, unsigned seed)
+{
+	std::mt19937_64 generator(seed);
+	std::uniform_real_distribution<SIdouble> distribution(min, max);
+	std::vector<T> values(N);
+	for (auto& x : values)
+		x = distribution(generator) * unit;
+	return values;
+}
+
+// The angle was a long double before, so all trigonometry ran in the x87 FPU (emulated below by casts).
+void trigonometry()
+{
+	std::printf("\nTRIGONOMETRY                                  before (long double)  after   speed-up\n");
+	const auto angles = random_values<angle>(1_rad, -constant::pi, constant::pi, 1);
+	std::vector<dimensionless> sines(N), cosines(N);
+	std::vector<angle> results(N);
+
+	const double sin_before = measure([&] { for (size_t i = 0; i < N; i++) sines[i] = double(std::sin((long double)angles[i])); });
+	report("sin(angle)", sin_before, measure([&] { for (size_t i = 0; i < N; i++) sines[i] = sin(angles[i]); }));
+	report("sin(angles, sines)", sin_before, measure([&] { sin(angles, sines); }));
+	report("sincos(angles, sines, cosines)", measure([&] { for (size_t i = 0; i < N; i++)
+		{
+			sines[i] = double(std::sin((long double)angles[i]));
+			cosines[i] = double(std::cos((long double)angles[i]));
+		} }), measure([&] { sincos(angles, sines, cosines); }));
+
+	const auto y = random_values(1_m, -100, 100, 2), x = random_values(1_m, -100, 100, 3);
+	const double atan2_before = measure([&] { for (size_t i = 0; i < N; i++) results[i] = double(std::atan2((long double)value(y[i]), (long double)value(x[i]))); });
+	report("atan2(y, x)", atan2_before, measure([&] { for (size_t i = 0; i < N; i++) results[i] = atan2(y[i], x[i]); }));
+	report("atan2(ys, xs, angles)", atan2_before, measure([&] { atan2(y, x, results); }));
+
+	const auto speeds = random_values(1_m_per_s, 50, 100, 4);
+	std::vector<velocity> climb_rates(N);
+	report("formula::climb_rate(speeds, angles, rates)", measure([&] { for (size_t i = 0; i < N; i++)
+		climb_rates[i] = meters_per_second(double(std::sin((long double)angles[i]) * value(speeds[i]))); }),
+		measure([&] { formula::climb_rate(speeds, angles, climb_rates); }));
+
+	const auto heights = random_values(1_m, 0, 10000, 5);
+	const auto latitudes = random_values<angle>(1_rad, -constant::pi / 2, constant::pi / 2, 6);
+	std::vector<acceleration> gravities(N);
+	report("formula::local_gravity(latitudes, heights, g)", measure([&] { for (size_t i = 0; i < N; i++)
+		{
+			const long double lat = latitudes[i], sin2_lat = 0.5L * (1 - std::cos(2 * lat)), sin2_2lat = 0.5L * (1 - std::cos(4 * lat));
+			gravities[i] = meters_per_second2(double(9.780327L * (1 + 0.0053024L * sin2_lat - 0.0000058L * sin2_2lat) - 3.086e-6L * value(heights[i])));
+		} }), measure([&] { formula::local_gravity(latitudes, heights, gravities); }));
+
+	const auto launch_angles = random_values<angle>(1_rad, 0.1, 1.4, 7);
+	std::vector<length> ranges(N);
+	const auto g = 9.81_m_per_s²;
+	report("formula::ballistic_max_range(...)", measure([&] { for (size_t i = 0; i < N; i++)
+		{
+			const long double a = launch_angles[i], v0 = value(speeds[i]), h = value(heights[i]), v_sin = v0 * std::sin(a);
+			ranges[i] = meters(double((v_sin + std::sqrt(v_sin * v_sin + 2 * value(g) * h)) / value(g) * std::cos(a) * v0));
+		} }), measure([&] { formula::ballistic_max_range(speeds, heights, launch_angles, g, ranges); }));
+}
+
+// The approximations of <SI/fast_math.h> compared to the exact functions (with the max. error against long double).
+void fast_math()
+{
+	std::printf("\nFAST MATH                                        SI::       fast::   speed-up  max.error\n");
+	const auto areas = random_values(1_m², 1e-6, 1e6, 8);
+	const auto volumes = random_values(1_m³, -1e6, 1e6, 9);
+	const auto angles = random_values<angle>(1_rad, -1000, 1000, 10);
+	const auto y = random_values(1_m, -100, 100, 11), x = random_values(1_m, -100, 100, 12);
+	const auto ratios = random_values<SIdouble>(1, 1e-9, 1e9, 13);
+	std::vector<length> lengths(N);
+	std::vector<SIdouble> results(N);
+	std::vector<angle> bearings(N);
+
+	report("sqrt(area) (relative)", measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = sqrt(areas[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = fast::sqrt(areas[i]); }),
+		max_error(N, [&](size_t i) { return value(fast::sqrt(areas[i])); }, [&](size_t i) { return std::sqrt((long double)value(areas[i])); }, true));
+	report("root<3>(volume) (relative)", measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = root<3>(volumes[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = fast::root<3>(volumes[i]); }),
+		max_error(N, [&](size_t i) { return value(fast::root<3>(volumes[i])); }, [&](size_t i) { return std::cbrt((long double)value(volumes[i])); }, true));
+	report("sin(angle) (absolute)", measure([&] { for (size_t i = 0; i < N; i++) results[i] = sin(angles[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) results[i] = fast::sin(angles[i]); }),
+		max_error(N, [&](size_t i) { return fast::sin(angles[i]); }, [&](size_t i) { return std::sin((long double)angles[i]); }, false));
+	report("cos(angle) (absolute)", measure([&] { for (size_t i = 0; i < N; i++) results[i] = cos(angles[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) results[i] = fast::cos(angles[i]); }),
+		max_error(N, [&](size_t i) { return fast::cos(angles[i]); }, [&](size_t i) { return std::cos((long double)angles[i]); }, false));
+	report("tan(angle) (relative)", measure([&] { for (size_t i = 0; i < N; i++) results[i] = tan(angles[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) results[i] = fast::tan(angles[i]); }),
+		max_error(N, [&](size_t i) { return fast::tan(angles[i]); }, [&](size_t i) { return std::tan((long double)angles[i]); }, true));
+	report("atan2(y, x) (relative)", measure([&] { for (size_t i = 0; i < N; i++) bearings[i] = atan2(y[i], x[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) bearings[i] = fast::atan2(y[i], x[i]); }),
+		max_error(N, [&](size_t i) { return fast::atan2(y[i], x[i]); }, [&](size_t i) { return std::atan2((long double)value(y[i]), (long double)value(x[i])); }, true));
+	report("log10(ratio) (absolute)", measure([&] { for (size_t i = 0; i < N; i++) results[i] = std::log10(ratios[i]); }),
+		measure([&] { for (size_t i = 0; i < N; i++) results[i] = fast::log10(ratios[i]); }),
+		max_error(N, [&](size_t i) { return fast::log10(ratios[i]); }, [&](size_t i) { return std::log10((long double)ratios[i]); }, false));
+}
+
+// Integer powers and roots called std::pow(x, Exponent) and std::pow(x, 1./Degree) before.
+void powers_and_roots()
+{
+	std::printf("\nPOWERS AND ROOTS                              before (std::pow)     after   speed-up\n");
+	const auto edges = random_values(1_m, 0, 100, 14);
+	const auto volumes = random_values(1_m³, 0, 1e6, 15);
+	const auto areas = random_values(1_m², 0, 1e4, 16);
+	std::vector<volume> cubes(N);
+	std::vector<length> lengths(N);
+	std::vector<SIdouble> results(N);
+
+	const double pow3_before = measure([&] { for (size_t i = 0; i < N; i++) cubes[i] = std::pow(value(edges[i]), 3) * 1_m³; });
+	report("pow<3>(length)", pow3_before, measure([&] { for (size_t i = 0; i < N; i++) cubes[i] = pow<3>(edges[i]); }));
+	report("pow<3>(lengths, volumes)", pow3_before, measure([&] { pow<3>(edges, cubes); }));
+	report("pow<-5>(length)", measure([&] { for (size_t i = 0; i < N; i++) results[i] = std::pow(value(edges[i]), -5); }),
+		measure([&] { for (size_t i = 0; i < N; i++) results[i] = value(pow<-5>(edges[i])); }));
+	const double sqrt_before = measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = std::pow(value(areas[i]), 1. / 2) * 1_m; });
+	report("root<2>(area)", sqrt_before, measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = root<2>(areas[i]); }));
+	report("sqrt(areas, lengths)", sqrt_before, measure([&] { sqrt(areas, lengths); }));
+	const double cbrt_before = measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = std::pow(value(volumes[i]), 1. / 3) * 1_m; });
+	report("root<3>(volume)", cbrt_before, measure([&] { for (size_t i = 0; i < N; i++) lengths[i] = root<3>(volumes[i]); }));
+	report("root<3>(volumes, lengths)", cbrt_before, measure([&] { root<3>(volumes, lengths); }));
+}
+
+// Packed length3 (24 bytes, AoS) against the padded vec3a (32 bytes, aligned) and tiles of 8 (AoSoA).
+void vector_layouts()
+{
+	std::printf("\nVECTOR LAYOUTS                                before (length3)      after   speed-up\n");
+	const auto x = random_values(1_m, -1, 1, 17), y = random_values(1_m, -1, 1, 18), z = random_values(1_m, -1, 1, 19);
+	std::vector<length3> a(N), b(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		a[i] = meters(value(x[i]), value(y[i]), value(z[i]));
+		b[i] = meters(value(z[i]), value(x[i]), value(y[i]));
+	}
+	const std::vector<length_t<vec3a<SIdouble>>> aligned_a(a.begin(), a.end()), aligned_b(b.begin(), b.end());
+	const auto tiles_a = pack(a), tiles_b = pack(b);
+	const size_t tiles = tiles_a.size();
+	std::vector<area> products(N);
+	std::vector<area_t<tile<SIdouble>>> tiled_products(tiles);
+	std::vector<area3> crosses(N);
+	std::vector<area_t<vec3a<SIdouble>>> aligned_crosses(N);
+	std::vector<area_t<tile3<SIdouble>>> tiled_crosses(tiles);
+	std::vector<decltype(normalize(a[0]))> directions(N);
+	std::vector<vec3a<SIdouble>> aligned_directions(N);
+	std::vector<tile3<SIdouble>> tiled_directions(tiles);
+
+	const double dot_before = measure([&] { for (size_t i = 0; i < N; i++) products[i] = dot(a[i], b[i]); });
+	report("dot(length3, length3) of vec3a", dot_before, measure([&] { for (size_t i = 0; i < N; i++) products[i] = dot(aligned_a[i], aligned_b[i]); }));
+	report("dot(length3, length3) of tile3", dot_before, measure([&] { for (size_t i = 0; i < tiles; i++) tiled_products[i] = dot(tiles_a[i], tiles_b[i]); }));
+	const double cross_before = measure([&] { for (size_t i = 0; i < N; i++) crosses[i] = cross(a[i], b[i]); });
+	report("cross(length3, length3) of vec3a", cross_before, measure([&] { for (size_t i = 0; i < N; i++) aligned_crosses[i] = cross(aligned_a[i], aligned_b[i]); }));
+	report("cross(length3, length3) of tile3", cross_before, measure([&] { for (size_t i = 0; i < tiles; i++) tiled_crosses[i] = cross(tiles_a[i], tiles_b[i]); }));
+	const double normalize_before = measure([&] { for (size_t i = 0; i < N; i++) directions[i] = normalize(a[i]); });
+	report("normalize(length3) of vec3a", normalize_before, measure([&] { for (size_t i = 0; i < N; i++) aligned_directions[i] = normalize(aligned_a[i]); }));
+	report("normalize(length3) of tile3", normalize_before, measure([&] { for (size_t i = 0; i < tiles; i++) tiled_directions[i] = normalize(tiles_a[i]); }));
+}
+
+// Rotating vector by vector with the quaternion against the batched kernels (matrix once, then 9 multiplications).
+void rotations()
+{
+	std::printf("\nROTATIONS                                     before (quat·v)       after   speed-up\n");
+	const auto x = random_values(1_m, -1, 1, 20), y = random_values(1_m, -1, 1, 21), z = random_values(1_m, -1, 1, 22);
+	std::vector<length3> positions(N), rotated(N);
+	for (size_t i = 0; i < N; i++)
+		positions[i] = meters(value(x[i]), value(y[i]), value(z[i]));
+	const auto tiles = pack(positions);
+	auto rotated_tiles = tiles;
+	const quat<> attitude = rotation({ 0.6, 0.8, 0 }, 30_deg);
+
+	const double before = measure([&] { for (size_t i = 0; i < N; i++) rotated[i] = rotate(attitude, positions[i]); });
+	report("rotate(quat, length3s)", before, measure([&] { rotate(attitude, positions, rotated); }));
+	report("rotate(quat, tile3s)", before, measure([&] { rotate(attitude, tiles, rotated_tiles); }));
+}
+
+// Naive sums against the compensated accumulator (the error relative to the sum of magnitudes, vs. long double).
+void sums()
+{
+	std::printf("\nSUMS                                          before (naive)        after   speed-up  max.error\n");
+	auto energies = random_values(1_J, -1, 1, 23);
+	const auto exponents = random_values(1.0, -8, 8, 24);
+	for (size_t i = 0; i < N; i++)
+		energies[i] *= std::pow(10.0, exponents[i]); // (magnitudes from 1e-8 to 1e8)
+	long double exact = 0, magnitudes = 0;
+	for (const auto& e : energies)
+	{
+		exact += value(e);
+		magnitudes += std::fabs(value(e));
+	}
+	energy naive = 0_J, total = 0_J;
+	const auto error_of = [&](energy e) { return double(std::fabs(value(e) - exact) / magnitudes); };
+
+	const double before = measure([&] { naive = 0_J; for (size_t i = 0; i < N; i++) naive += energies[i]; });
+	const double after = measure([&] { total = sum(energies); });
+	std::printf("%-46s %47.1e\n", "(the naive loop)", error_of(naive));
+	report("sum(energies)", before, after, error_of(total));
+	report("sum(parallel, energies)", before, measure([&] { total = sum(parallel_t{ 1 << 12 }, energies); }), error_of(total));
+}
+
+// SI_CHECKED_MATH adds two calls per batch, emulated below (as in detail::fp_check, build with -DSI_CHECKED_MATH for the real ones).
+template <class Function>
+void checked(Function&& function)
+{
+	const int raised_before = std::fetestexcept(detail::checked_fp_exceptions);
+	if (raised_before != 0)
+		std::feclearexcept(raised_before);
+	function();
+	if (std::fetestexcept(detail::checked_fp_exceptions))
+		std::printf("(floating-point exception)\n");
+	if (raised_before != 0)
+		std::feraiseexcept(raised_before);
+}
+
+void checked_math()
+{
+	std::printf("\nCHECKED MATH                                  before (unchecked)    after   speed-up\n");
+	const auto masses = random_values(1_kg, 1, 2000, 25);
+	const auto velocities = random_values(1_m_per_s, 0, 100, 26);
+	std::vector<energy> energies(N);
+	constexpr size_t small = 64; // (elements per call)
+
+	report("kinetic_energy(masses, velocities, energies)", measure([&] { formula::kinetic_energy(masses, velocities, energies); }),
+		measure([&] { checked([&] { formula::kinetic_energy(masses, velocities, energies); }); }));
+	const auto small_batches = [&](bool check)
+	{
+		for (size_t i = 0; i < N; i += small)
+		{
+			const auto call = [&] { formula::kinetic_energy(span<const mass>(masses.data() + i, small), span<const velocity>(velocities.data() + i, small),
+				span<energy>(energies.data() + i, small)); };
+			check ? checked(call) : call();
+		}
+	};
+	report("(the same in batches of 64)", measure([&] { small_batches(false); }), measure([&] { small_batches(true); }));
+}
+
+int main()
+{
+	std::printf("SI benchmarks (%zu elements per batch)\n", N);
+	trigonometry();
+	powers_and_roots();
+	fast_math();
+	vector_layouts();
+	rotations();
+	sums();
+	checked_math();
+	return 0;
+}
@@ -291,6 +291,193 @@ int main() {
 		auto wavelength = formula::wavelength(constant::speed_of_sound, note.frequency);
 		printf("%s%d=%s/%s ", note.name, note.octave, to_string(note.frequency).c_str(), to_string(wavelength).c_str());
 	}
+} {
+	print("\n43. What are the diameters and densities of all planets (as CSV)?\n");
+	csv_writer(stdout).rows(dataset::planets,
+		field(&dataset::planet_data::name, "name"),
+		field(&dataset::planet_data::diameter, "diameter", kilometers, "km"),
+		field(&dataset::planet_data::density, "density", grams_per_centimeter3, "g/cm³"));
+} {
+	print("\n44. What's the average of these temperatures measured in °F? ");
+	const double measured_fahrenheit[] = { 68.0, 71.6, 75.2, 64.4, 59.0 };
+	temperature temperatures[5];
+	convert(measured_fahrenheit, fahrenheit, temperatures);
+	print((temperatures[0] + temperatures[1] + temperatures[2] + temperatures[3] + temperatures[4]) / 5.0);
+} {
+	print("\n45. What are the braking distances on dry asphalt at 30, 50, 100 and 130 km/h? ");
+	const velocity speeds[] = { 30_km_per_h, 50_km_per_h, 100_km_per_h, 130_km_per_h };
+	length distances[4];
+	formula::braking_distance(speeds, 0_km_per_h, 8_m_per_s², distances);
+	print(distances[0]); print(", "); print(distances[1]); print(", "); print(distances[2]); print(", "); print(distances[3]);
+} {
+	print("\n46. What's the speed of sound at -20, 0, 20 and 40 °C (computed at compile-time)? ");
+	constexpr velocity speeds_of_sound[] = { formula::speed_of_sound_in_air(celsius(-20.0)), formula::speed_of_sound_in_air(celsius(0.0)),
+		formula::speed_of_sound_in_air(celsius(20.0)), formula::speed_of_sound_in_air(celsius(40.0)) };
+	for (auto speed : speeds_of_sound)
+		print(speed), print(" ");
+} {
+	print("\n47. What's the air density and speed of sound at flight level 350? ");
+	const auto atmosphere = ISA::state_at(35'000_ft);
+	print(atmosphere.air_density); print(", "); print(atmosphere.speed_of_sound);
+} {
+	print("\n48. How far does a golf ball fly when hit at 70 m/s and 12°, with and without air drag? ");
+	const ballistics::projectile golf_ball = { 45.93_g, 0.25, constant::pi * square(21.335_mm) };
+	const ballistics::state start = { 0_s, meters(0.0, 0.0, 0.0), meters_per_second(70.0 * cos(0.2094), 0.0, 70.0 * sin(0.2094)) };
+	const auto with_drag = ballistics::fly_rk45(start, golf_ball, ballistics::environment());
+	print(meters(value(with_drag.back().position).x)); print(" or ");
+	print(formula::ballistic_max_range(70_m_per_s, 0_m, 0.2094, constant::g_n));
+} {
+	print("\n49. How far is the Earth from the Sun half a year after its perihelion? ");
+	const orbit::elements Earth_orbit = { 1.000001018_au, 0.0167086, 365.256363004_days };
+	print(norm(orbit::state_at(Earth_orbit, 0.5 * Earth_orbit.period).position) / 1_au); print(" AU");
+} {
+	print("\n50. How much energy does a leapfrog simulation of the Sun and the Earth drift within a year (hourly steps)? ");
+	nbody::simulation sim({ { 1.98847e30_kg, meters(0.0, 0.0, 0.0), meters_per_second(0.0, 0.0, 0.0) },
+		{ 5.9722e24_kg, meters(value(1_au), 0.0, 0.0), meters_per_second(0.0, 29780.0, 0.0) } });
+	for (int hour = 0; hour < 24 * 365; hour++)
+		sim.step(1_h);
+	print(sim.energy_drift()); print(" (of ~2.65e33 J in total)");
+} {
+	print("\n51. How many points of a 10×10×10 lattice with 1m spacing are within 1.5m of an inner point, and how far is the 20th nearest? ");
+	std::vector<length3> lattice;
+	for (int x = 0; x < 10; x++)
+		for (int y = 0; y < 10; y++)
+			for (int z = 0; z < 10; z++)
+				lattice.push_back(meters(double(x), double(y), double(z)));
+	const spatial::kd_tree tree(lattice);
+	print(double(tree.within(meters(5.0, 5.0, 5.0), 1.5_m).size())); print(" points, "); print(tree.nearest(meters(5.0, 5.0, 5.0), 20).back().distance);
+} {
+	print("\n52. What's the braking distance from 100 ± 5 km/h when braking with 7.5 to 8.5 m/s²? ");
+	using bounds = interval<SIdouble>;
+	print(formula::braking_distance<bounds>(kilometers_per_hour(bounds(95.0, 105.0)), 0_km_per_h, meters_per_second2(bounds(7.5, 8.5))));
+} {
+	print("\n53. How much longer is the braking distance from 100 km/h at 8 m/s² per 1 km/h more speed, and per 1 m/s² less braking? ");
+	const auto speed = variable<2>(100_km_per_h, 0); // (2 variables, derived in one pass)
+	const auto braking = variable<2>(8_m_per_s², 1);
+	const auto distance = formula::braking_distance<dual<SIdouble, 2>>(speed, 0_km_per_h, braking);
+	print(derivative(distance, speed) * 1_km_per_h); print(" or "); print(-derivative(distance, braking) * 1_m_per_s²);
+} {
+	print("\n54. Between which kinetic energies is a car of 1500 ± 50 kg at 100 ± 5 km/h in 95% of all cases? ");
+	const auto energies = monte_carlo::propagate(parallel, { 100000 }, formula::kinetic_energy<SIdouble>,
+		monte_carlo::normal(1500_kg, 50_kg), monte_carlo::normal(100_km_per_h, 5_km_per_h));
+	print(energies.quantile(0.025)); print(" … "); print(energies.quantile(0.975));
+	const auto none = monte_carlo::propagate({ 0 }, formula::kinetic_energy<SIdouble>, monte_carlo::normal(1500_kg, 50_kg), 100_km_per_h);
+	if (none.samples() != 0 || !std::isnan(value(none.quantile(0.5))) || !std::isnan(value(none.minimum())) || !std::isnan(value(none.mean())))
+		return 1; // (fails the examples test, no samples have NaN statistics)
+} {
+	print("\n55. How far east and north does a 10km hike lead at the bearings of 30°, 45° and 60°? ");
+	const std::vector<angle> bearings = { 30_deg, 45_deg, 60_deg };
+	std::vector<dimensionless> sines(bearings.size()), cosines(bearings.size());
+	sincos(bearings, sines, cosines); // (in one vectorized loop)
+	for (size_t i = 0; i < bearings.size(); i++)
+	{
+		print(sines[i] * 10_km); print(" east + "); print(cosines[i] * 10_km); print(i + 1 < bearings.size() ? " north, " : " north");
+	}
+} {
+	print("\n56. What's the edge length of a cube-shaped water tank holding 8m³, and the slope of its space diagonal? ");
+	const length edge = fast::root<3>(8_m³); // (fast approximations, still dimension-checked)
+	print(edge); print(" and "); print(fast::atan2(edge, fast::sqrt(2 * edge * edge)));
+} {
+	print("\n57. Where's the tip of a 2m long robot arm pointing east after turning at 90°/s around the vertical for 0.5s, and how fast is that? ");
+	quat<> attitude; // (no rotation)
+	for (int step = 0; step < 50; step++)
+		attitude = integrate(attitude, radians_per_second(0.0, 0.0, SIdouble(90_deg)), 10_ms);
+	const length3 tip = rotate(attitude, meters(2.0, 0.0, 0.0));
+	print(value(tip).x * 1_m); print(" east, "); print(value(tip).y * 1_m); print(" north");
+	print(", "); print(radians_per_second(SIdouble(90_deg)));
+} {
+	print("\n58. Which batched formula turns a negative drop height into NaN, but not atan2() at the origin (reported with -DSI_CHECKED_MATH)? ");
+	static std::string reported = "none (checked math is off)";
+	set_fp_error_handler([](const fp_error& error) { reported = std::string(error.function) + "(" + error.inputs + ")"; });
+	const length ys[] = { 0_m, 1_m, meters(std::numeric_limits<SIdouble>::infinity()) }, xs[] = { 0_m, meters(-std::numeric_limits<SIdouble>::infinity()), 1_m };
+	angle directions[3];
+	atan2(ys, xs, directions); // (valid input, so nothing is reported)
+	if (reported != "none (checked math is off)")
+		return 1; // (fails the examples test)
+	const length heights[] = { 10_m, -10_m };
+	SI::time fall_times[2];
+	formula::time_of_free_fall(heights, constant::g_n, fall_times);
+	print(reported);
+} {
+	print("\n59. Which formulas and conversions took the most cycles so far (counted with -DSI_INSTRUMENTATION)? ");
+	print(instrumentation::to_json(3));
+} {
+	print("\n60. How does 1234.5m look with 3 digits and a space, in base units, and with no digits in another thread? ");
+	print(to_string(1234.5_m, { 3, true })); print(", "); print(to_string(1234.5_m, { 2, false, true })); print(", ");
+	std::string formatted_by_other_thread;
+	std::thread([&] { format_of_to_string().precision = 0; formatted_by_other_thread = to_string(1234.5_m); }).join();
+	print(formatted_by_other_thread); print(" (still "); print(1234.5_m); print(" here)");
+} {
+	print("\n61. Does a golf ball thrown down on the ground land at once, and do golf balls flying together land where each alone does? ");
+	const ballistics::projectile golf_ball = { 45.93_g, 0.25, constant::pi * square(21.335_mm) };
+	const auto thrown_down = ballistics::fly_rk45({ 0_s, meters(0.0, 0.0, 0.0), meters_per_second(10.0, 0.0, -5.0) }, golf_ball, ballistics::environment());
+	const bool landed_at_once = thrown_down.size() == 1 && thrown_down.back().time == 0_s;
+	const ballistics::state starts[] = { { 0_s, meters(0.0, 0.0, 0.0), meters_per_second(60.0, 0.0, 15.0) },
+		{ 0_s, meters(0.0, 0.0, 0.0), meters_per_second(70.0, 0.0, 25.0) }, { 0_s, meters(0.0, 0.0, 2.0), meters_per_second(10.0, 0.0, 0.0) } };
+	const ballistics::projectile golf_balls[] = { golf_ball, golf_ball, golf_ball };
+	const auto together = ballistics::fly_rk4(starts, golf_balls, ballistics::environment(), 10_ms);
+	bool same_landings = true;
+	for (size_t i = 0; i < 3; i++)
+	{
+		const auto alone = ballistics::fly_rk4(starts[i], golf_ball, ballistics::environment(), 10_ms);
+		same_landings = same_landings && alone.size() == together[i].size() && abs(alone.back().time - together[i].back().time) < 1_ns
+			&& norm(alone.back().position - together[i].back().position) < 1_um;
+	}
+	print(landed_at_once ? "yes" : "NO"); print(", "); print(same_landings ? "yes" : "NO");
+	if (!landed_at_once || !same_landings)
+		return 1; // (fails the examples test)
+} {
+	print("\n62. What's the largest residual |E - e·sin(E) - M| of Kepler's equation solved for eccentricities up to 0.99999? ");
+	SIdouble worst_residual = 0;
+	for (SIdouble e : { 0.0, 0.3, 0.6, 0.9, 0.99, 0.999, 0.9995, 0.99999 })
+		for (int k = -1999; k < 2000; k++)
+		{
+			const SIdouble M = constant::pi * k / 2000 * (k % 2 == 0 ? 1 : 1e-6); // (and many near the periapsis)
+			const SIdouble E = static_cast<SIdouble>(orbit::eccentric_anomaly(M, e));
+			worst_residual = std::max(worst_residual, std::fabs(E - e * std::sin(E) - M));
+		}
+	printf("%.1e", worst_residual);
+	if (!(worst_residual < 1e-15))
+		return 1; // (fails the examples test)
+} {
+	print("\n63. How many exoplanets of the dataset have known orbits, and how far is the farthest from its star 100 days later? ");
+	std::vector<orbit::elements> exoplanet_orbits;
+	for (auto& exoplanet : dataset::exoplanets)
+	{
+		orbit::elements o;
+		if (orbit::elements_of(exoplanet, o))
+			exoplanet_orbits.push_back(o);
+	}
+	std::vector<orbit::state> states(exoplanet_orbits.size());
+	orbit::state_at(exoplanet_orbits, 100_days, states);
+	length farthest = 0_m;
+	for (auto& s : states)
+		farthest = std::max(farthest, norm(s.position));
+	printf("%zu of %zu, ", exoplanet_orbits.size(), std::size(dataset::exoplanets)); print(farthest / 1_au); print(" AU");
+} {
+	print("\n64. How many points of a 10×10×10 lattice in a grid of 1m cells are within 300km and 1e300m of its corner? ");
+	std::vector<length3> lattice;
+	for (int x = 0; x < 10; x++)
+		for (int y = 0; y < 10; y++)
+			for (int z = 0; z < 10; z++)
+				lattice.push_back(meters(double(x), double(y), double(z)));
+	const spatial::uniform_grid grid(lattice, 1_m);
+	const size_t within_300km = grid.within(meters(0.0, 0.0, 0.0), 300_km).size(), within_1e300m = grid.within(meters(0.0, 0.0, 0.0), meters(1e300)).size();
+	printf("%zu and %zu", within_300km, within_1e300m);
+	if (within_300km != lattice.size() || within_1e300m != lattice.size())
+		return 1; // (fails the examples test)
+} {
+	print("\n65. What's 30° + 15°, twice 30°, the negative of 30° and 90° split in three? ");
+	const std::string sums[] = { to_string(30_deg + 15_deg), to_string(2.0 * 30_deg), to_string(-30_deg), to_string(90_deg / 3) };
+	printf("%s, %s, %s, %s", sums[0].c_str(), sums[1].c_str(), sums[2].c_str(), sums[3].c_str());
+	if (sums[0] != "45.00°" || sums[1] != "60.00°" || sums[2] != "-30.00°" || sums[3] != "30.00°")
+		return 1; // (fails the examples test)
+} {
+	print("\n66. How are 1 day, 2 days and a week displayed? ");
+	const std::string durations[] = { to_string(1_day), to_string(2_days), to_string(7_days) };
+	printf("%s, %s, %s", durations[0].c_str(), durations[1].c_str(), durations[2].c_str());
+	if (durations[0] != "24.00h" || durations[1] != "2.00days" || durations[2] != "1.00 week(s)")
+		return 1; // (fails the examples test)
 } {
 	// Conversion example:
 	dimensionless x = 42;      // <- x contains a dimensionless number (no unit)